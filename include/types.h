@@ -19,26 +19,81 @@ typedef enum _VTOL_State {
   IN_FLIGHT,            // Flying at cruising speed
   CHARGING,             // Charging battery
   WAITING_TO_CHARGE,    // Waiting for charger to become available
+  WAITING_FOR_MAINTENANCE, // Grounded after a fault, waiting for a maintenance bay
+  IN_MAINTENANCE,       // Being serviced in a maintenance bay
   MAX_STATES
 } VTOL_State_e;
 
 // Structure for VTOL sim statistics
-typedef struct  VTOLStats_t{
-  float total_charge_time_hr;     // Total time spent charging (TODO: doc says to track time "per session", but does that mean altogether, or include the waiting time?)
+// Templated over scalar type so the sim can be run with dual numbers
+template <typename T>
+struct VTOLStats_T {
+  T total_charge_time_hr;         // Total time spent charging (TODO: doc says to track time "per session", but does that mean altogether, or include the waiting time?)
   int num_faults;                 // Total faults accrued while in flight
-  float vehicle_fly_time_hr;      // Total hours flown
-  float vehicle_fly_distance_mi;  // Total number of miles flown for the vehicle
-  float charge_wait_time_hr;      // Total time spent waiting to charge
+  T vehicle_fly_time_hr;          // Total hours flown
+  T vehicle_fly_distance_mi;      // Total number of miles flown for the vehicle
+  T charge_wait_time_hr;          // Total time spent waiting to charge
+  double fault_log_weight;        // Log likelihood ratio of all fault draws (0 unless importance sampling)
+  T maintenance_wait_time_hr;     // Total time grounded, waiting for a maintenance bay
+  T maintenance_time_hr;          // Total time being serviced
+  int num_groundings;             // Times grounded after a faulty flight
 };
+typedef VTOLStats_T<float> VTOLStats_t;
 
 // Structure for VTOL sim parameters
-typedef struct VTOLParams_t{
-  int cruise_speed_mph;
-  int battery_capacity_kwh;
-  float chg_time_hr;
-  float energy_use_kwh_per_mi;
-  float fault_prob_per_hr;
+template <typename T>
+struct VTOLParams_T {
+  T cruise_speed_mph;
+  T battery_capacity_kwh;
+  T chg_time_hr;
+  T energy_use_kwh_per_mi;
+  T fault_prob_per_hr;
 };
+typedef VTOLParams_T<float> VTOLParams_t;
+
+// Parameter indices, in VTOLParams_T field order (used for sensitivities)
+typedef enum _VTOL_Param {
+  CRUISE_SPEED,
+  BATTERY_CAPACITY,
+  CHG_TIME,
+  ENERGY_USE,
+  FAULT_PROB,
+  MAX_PARAMS
+} VTOL_Param_e;
+
+// Per-company aggregated statistics, as output by FlightSim
+template <typename T>
+struct CompanyStats_T {
+  int num_vtols;                  // Number of eVTOLs for company
+  T avg_flight_time_hr;           // Average time in flight
+  T avg_flight_distance_mi;       // Average distance flown
+  T avg_charging_time_hr;         // Average time charging
+  T avg_waiting_time_hr;          // Average time waiting for a charger
+  int total_faults;               // Total faults across all instances
+  T total_passenger_miles;        // Total passenger miles
+  double weighted_faults;         // Likelihood-ratio weighted total faults (unbiased under importance sampling)
+};
+typedef CompanyStats_T<float> CompanyStats_t;
+
+/**
+ * @brief Convert float parameters to another scalar type
+ * 
+ * @tparam T - Target scalar type
+ * @param params - Float parameters (e.g. from COMP_MAP)
+ * @return VTOLParams_T<T> - Parameters with scalar type T
+ */
+template <typename T>
+VTOLParams_T<T> convert_params(const VTOLParams_t& params)
+{
+  VTOLParams_T<T> out = {
+    params.cruise_speed_mph,
+    params.battery_capacity_kwh,
+    params.chg_time_hr,
+    params.energy_use_kwh_per_mi,
+    params.fault_prob_per_hr
+  };
+  return out;
+}
 
 // Company-specific parameters
 // Alpha
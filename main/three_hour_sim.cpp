@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cstdlib>
 #include <flight_sim.h>
 
 // Simulation parameters
@@ -18,6 +19,8 @@ int main(int argc, char *argv[])
 
   // Instantiate flight sim class
   FlightSim sim_inst = FlightSim(NUM_VTOLS, NUM_CHARGERS, FLIGHT_SIM_HR_PER_TICK);
+  // Optional fault seed, recorded in the results archive
+  if (argc > 2) sim_inst.seed_faults(strtoul(argv[2], nullptr, 10));
   sim_inst.display_company_makeup();
 
   // Simulate flight
@@ -26,5 +29,14 @@ int main(int argc, char *argv[])
   // Print stats
   sim_inst.aggregate_company_stats();
 
+  // Optionally append this run to a results archive (see tools/results_query)
+  if (argc > 1) {
+    ResultsArchiveWriter archive(argv[1]);
+    if (!archive.append(sim_inst.get_run_record())) {
+      cerr << "Could not append to results archive '" << argv[1] << "'" << endl;
+      return 1;
+    }
+  }
+
   return 0;
 }
@@ -0,0 +1,300 @@
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <types.h>
+#include <company_stats.h>
+#include <flight_sim.h>
+#include "aggregate_sim.h"
+
+AggregateSim::AggregateSim(const std::vector<int64_t>& company_counts, int64_t num_chargers, double bucket_hr)
+{
+  if (company_counts.size() != MAX_COMPANIES) {
+    throw std::runtime_error("Expected one eVTOL count per company!");
+  }
+  if (num_chargers < 0 || bucket_hr <= 0) {
+    throw std::runtime_error("Invalid aggregate sim configuration!");
+  }
+
+  this->bucket_hr    = bucket_hr;
+  curr_timestamp     = 0;
+  chargers_available = num_chargers;
+
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    const VTOLParams_t& params = COMP_MAP.at(static_cast<VTOL_Comp_e>(company));
+    // As per eVTOL_Sim_T::get_flight_time_hr
+    flight_time_hr[company] = params.battery_capacity_kwh / (params.energy_use_kwh_per_mi * params.cruise_speed_mph);
+    chg_time_hr[company]    = params.chg_time_hr;
+
+    num_vtols[company]            = company_counts[company];
+    num_in_flight[company]        = 0;
+    num_charging[company]         = 0;
+    num_waiting[company]          = 0;
+    total_fly_time_hr[company]    = 0;
+    total_charge_time_hr[company] = 0;
+    total_wait_time_hr[company]   = 0;
+    total_faults[company]         = 0;
+
+    // Every eVTOL starts a flight at t=0
+    if (num_vtols[company] > 0) {
+      _add_to_bin(flight_bins[company], num_vtols[company], flight_time_hr[company]);
+      num_in_flight[company] = num_vtols[company];
+    }
+  }
+}
+
+void AggregateSim::seed_faults(unsigned int seed)
+{
+  rand_gen.seed(seed);
+}
+
+void AggregateSim::_add_to_bin(std::map<int64_t, AggBin_t>& bins, int64_t count, double phase_end)
+{
+  AggBin_t& bin = bins[(int64_t)floor(phase_end / bucket_hr)];
+  bin.phase_end = (bin.phase_end * bin.count + phase_end * count) / (bin.count + count);
+  bin.count    += count;
+}
+
+void AggregateSim::_advance_to(double timestamp)
+{
+  double diff = timestamp - curr_timestamp;
+  if (diff <= 0) return;
+
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    total_fly_time_hr[company]    += num_in_flight[company] * diff;
+    total_charge_time_hr[company] += num_charging[company] * diff;
+    total_wait_time_hr[company]   += num_waiting[company] * diff;
+
+    // Faults arrive independently per eVTOL in flight
+    double mean_faults = num_in_flight[company] * COMP_MAP.at(static_cast<VTOL_Comp_e>(company)).fault_prob_per_hr * diff;
+    if (mean_faults > 0) {
+      std::poisson_distribution<int64_t> fault_dist(mean_faults);
+      total_faults[company] += fault_dist(rand_gen);
+    }
+  }
+  curr_timestamp = timestamp;
+}
+
+int64_t AggregateSim::_start_charges(AggWaiting_t& group, int64_t num_chargers)
+{
+  int64_t share[MAX_COMPANIES];
+  int64_t used = 0;
+  if (num_chargers >= group.total) {
+    for (int company = 0; company < MAX_COMPANIES; company++) share[company] = group.count[company];
+    used = group.total;
+  } else {
+    // Largest remainder split of the chargers by company count
+    double remainder[MAX_COMPANIES];
+    for (int company = 0; company < MAX_COMPANIES; company++)
+    {
+      double quota      = (double)num_chargers * group.count[company] / group.total;
+      share[company]     = (int64_t)floor(quota);
+      remainder[company] = quota - share[company];
+      used += share[company];
+    }
+    while (used < num_chargers)
+    {
+      int best = -1;
+      for (int company = 0; company < MAX_COMPANIES; company++) {
+        if (share[company] < group.count[company] && (best < 0 || remainder[company] > remainder[best])) best = company;
+      }
+      ++share[best];
+      remainder[best] = -1;
+      ++used;
+    }
+  }
+
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    if (share[company] == 0) continue;
+    num_waiting[company]  -= share[company];
+    num_charging[company] += share[company];
+    group.count[company]  -= share[company];
+    _add_to_bin(charge_bins[company], share[company], curr_timestamp + chg_time_hr[company]);
+  }
+  group.total -= used;
+  return used;
+}
+
+void AggregateSim::_arrive_for_charge(AggWaiting_t& arrivals)
+{
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    num_in_flight[company] -= arrivals.count[company];
+    num_waiting[company]   += arrivals.count[company];
+  }
+
+  // Only arrivals beyond the free chargers (or behind a queue) wait
+  if (wait_q.empty()) chargers_available -= _start_charges(arrivals, chargers_available);
+  if (arrivals.total > 0) wait_q.push_back(arrivals);
+}
+
+void AggregateSim::_release_chargers(int64_t count)
+{
+  // Waiting eVTOLs start charging right away, first come first served
+  while (count > 0 && !wait_q.empty())
+  {
+    count -= _start_charges(wait_q.front(), count);
+    if (wait_q.front().total == 0) wait_q.pop_front();
+  }
+  chargers_available += count;
+}
+
+void AggregateSim::sim_flight(double sim_time_hr)
+{
+  while (true)
+  {
+    // Earliest bin across all companies and states; charges end first on
+    // ties, so released chargers are free for same-time arrivals
+    std::map<int64_t, AggBin_t>* next_bins = nullptr;
+    VTOL_Comp_e next_company = ALPHA;
+    bool next_is_flight = false;
+    double next_end = INFINITY;
+    for (int company = 0; company < MAX_COMPANIES; company++)
+    {
+      if (!charge_bins[company].empty() && charge_bins[company].begin()->second.phase_end < next_end) {
+        next_bins      = &charge_bins[company];
+        next_company   = static_cast<VTOL_Comp_e>(company);
+        next_is_flight = false;
+        next_end       = next_bins->begin()->second.phase_end;
+      }
+    }
+    for (int company = 0; company < MAX_COMPANIES; company++)
+    {
+      if (!flight_bins[company].empty() && flight_bins[company].begin()->second.phase_end < next_end) {
+        next_bins      = &flight_bins[company];
+        next_company   = static_cast<VTOL_Comp_e>(company);
+        next_is_flight = true;
+        next_end       = next_bins->begin()->second.phase_end;
+      }
+    }
+
+    if (next_bins == nullptr || next_end > sim_time_hr) break;
+    _advance_to(next_end);
+
+    if (next_is_flight) {
+      // Flights of every company ending in the same bucket arrive together
+      int64_t bucket = next_bins->begin()->first;
+      AggWaiting_t arrivals = AggWaiting_t();
+      for (int company = 0; company < MAX_COMPANIES; company++)
+      {
+        if (flight_bins[company].empty() || flight_bins[company].begin()->first != bucket) continue;
+        arrivals.count[company] = flight_bins[company].begin()->second.count;
+        arrivals.total         += arrivals.count[company];
+        flight_bins[company].erase(flight_bins[company].begin());
+      }
+      _arrive_for_charge(arrivals);
+    } else {
+      // Go directly into flight, then hand over the chargers
+      int64_t count = next_bins->begin()->second.count;
+      next_bins->erase(next_bins->begin());
+      num_charging[next_company]  -= count;
+      num_in_flight[next_company] += count;
+      _add_to_bin(flight_bins[next_company], count, curr_timestamp + flight_time_hr[next_company]);
+      _release_chargers(count);
+    }
+  }
+
+  _advance_to(sim_time_hr);
+}
+
+CompanyStats_t AggregateSim::get_company_stats(VTOL_Comp_e company)
+{
+  CompanyStats_t out = CompanyStats_t();
+  out.num_vtols = num_vtols[company];
+  if (num_vtols[company] == 0) return out;
+
+  const VTOLParams_t& params = COMP_MAP.at(company);
+  double distance_mi = total_fly_time_hr[company] * params.cruise_speed_mph;
+
+  out.avg_flight_time_hr     = total_fly_time_hr[company] / num_vtols[company];
+  out.avg_flight_distance_mi = distance_mi / num_vtols[company];
+  out.avg_charging_time_hr   = total_charge_time_hr[company] / num_vtols[company];
+  out.avg_waiting_time_hr    = total_wait_time_hr[company] / num_vtols[company];
+  out.total_faults           = total_faults[company];
+  out.weighted_faults        = total_faults[company];
+  out.total_passenger_miles  = distance_mi * VTOL_PASSENGERS.at(company);
+  return out;
+}
+
+void AggregateSim::aggregate_company_stats()
+{
+  std::cout << "Company Statistics:\n" << std::endl;
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(company);
+    if (num_vtols[company] == 0)
+    {
+      std::cout << "No eVTOLs instantiated for " << COMP_NAMES.at(comp_enum) << " company.\n" << std::endl;
+      continue;
+    }
+
+    display_company_stats(comp_enum, get_company_stats(comp_enum), false);
+  }
+}
+
+// Print the relative error of an estimate against a reference. A zero
+// reference has no relative error, so the absolute one is shown instead
+static void display_rel_error(const char* label, double estimate, double reference)
+{
+  std::cout << "\t" << label;
+  if (reference != 0) {
+    std::cout << fabs(estimate - reference) / fabs(reference);
+  } else if (estimate == 0) {
+    std::cout << 0;
+  } else {
+    std::cout << "n/a (absolute " << fabs(estimate) << ")";
+  }
+  std::cout << std::endl;
+}
+
+void AggregateSim::display_error(FlightSim& agent)
+{
+  std::cout << "Aggregate vs. Agent Relative Error:\n" << std::endl;
+  double agg_hr[3] = {}, ref_hr[3] = {}; // Fleet-wide flight, charging and waiting hours
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(company);
+    CompanyStats_t agg = get_company_stats(comp_enum);
+    CompanyStats_t ref = agent.get_company_stats(comp_enum);
+    if (ref.num_vtols != agg.num_vtols) {
+      throw std::runtime_error("Agent sim has a different company mix!");
+    }
+    if (agg.num_vtols == 0) continue;
+
+    agg_hr[0] += agg.avg_flight_time_hr * agg.num_vtols;
+    ref_hr[0] += ref.avg_flight_time_hr * ref.num_vtols;
+    agg_hr[1] += agg.avg_charging_time_hr * agg.num_vtols;
+    ref_hr[1] += ref.avg_charging_time_hr * ref.num_vtols;
+    agg_hr[2] += agg.avg_waiting_time_hr * agg.num_vtols;
+    ref_hr[2] += ref.avg_waiting_time_hr * ref.num_vtols;
+
+    std::cout << COMP_NAMES.at(comp_enum) << ":" << std::endl;
+    display_rel_error("Avg. Flight Time:      ", agg.avg_flight_time_hr, ref.avg_flight_time_hr);
+    display_rel_error("Avg. Flight Distance:  ", agg.avg_flight_distance_mi, ref.avg_flight_distance_mi);
+    display_rel_error("Avg. Charging Time:    ", agg.avg_charging_time_hr, ref.avg_charging_time_hr);
+    display_rel_error("Total Faults:          ", agg.total_faults, ref.total_faults);
+    display_rel_error("Total Passenger Miles: ", agg.total_passenger_miles, ref.total_passenger_miles);
+    display_rel_error("Avg. Waiting Time:     ", agg.avg_waiting_time_hr, ref.avg_waiting_time_hr);
+    std::cout << std::endl;
+  }
+
+  // What the mean-field model tracks best, see README
+  std::cout << "Fleet-wide:" << std::endl;
+  display_rel_error("Flight Hours:          ", agg_hr[0], ref_hr[0]);
+  display_rel_error("Charging Hours:        ", agg_hr[1], ref_hr[1]);
+  display_rel_error("Waiting Hours:         ", agg_hr[2], ref_hr[2]);
+  std::cout << std::endl;
+}
+
+size_t AggregateSim::get_num_bins()
+{
+  size_t num_bins = 0;
+  for (int company = 0; company < MAX_COMPANIES; company++) {
+    num_bins += flight_bins[company].size() + charge_bins[company].size();
+  }
+  return num_bins;
+}
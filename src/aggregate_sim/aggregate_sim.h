@@ -0,0 +1,173 @@
+/**
+ * Population-count (mean-field) flight simulator
+ *
+ * Instead of one eVTOL_Sim per vehicle, tracks per company how many
+ * vehicles are in each state, binned by when their current flight or charge
+ * ends. Vehicles whose phase ends fall in the same bucket are merged (at
+ * their count-weighted mean end time), so memory and time scale with the
+ * number of distinct timing buckets rather than the fleet size.
+ *
+ * The sim is event driven in continuous time: the earliest bin ends its
+ * phase, takes chargers (or joins the FIFO wait queue) or releases them to
+ * waiting vehicles, and state counts are integrated in between. It differs
+ * from the agent model (FlightSim) only in that transitions aren't snapped
+ * to ticks, same-time arrivals are served in time rather than vehicle
+ * order, and faults are drawn as a Poisson count per company and interval.
+ */
+
+#ifndef _AGGREGATE_SIM_
+#define _AGGREGATE_SIM_
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <random>
+#include <vector>
+#include <types.h>
+
+class FlightSim;
+
+// Vehicles of one company and state whose phase ends in the same bucket
+typedef struct AggBin_t {
+  int64_t count;      // Number of vehicles
+  double phase_end;   // Count-weighted mean timestamp the phase ends at
+} AggBin_t;
+
+// Vehicles that arrived for a charger at the same time and are still waiting
+typedef struct AggWaiting_t {
+  int64_t count[MAX_COMPANIES]; // Per company
+  int64_t total;                // Across companies
+} AggWaiting_t;
+
+class AggregateSim {
+  private:
+    double bucket_hr;      // Width of a timing bucket
+    double curr_timestamp; // Current sim time
+
+    // Per company parameters
+    double flight_time_hr[MAX_COMPANIES];
+    double chg_time_hr[MAX_COMPANIES];
+
+    // Histograms, per company, of vehicles in flight / charging keyed by
+    // the bucket their phase ends in
+    std::map<int64_t, AggBin_t> flight_bins[MAX_COMPANIES];
+    std::map<int64_t, AggBin_t> charge_bins[MAX_COMPANIES];
+
+    // Charger pool
+    int64_t chargers_available;
+    std::deque<AggWaiting_t> wait_q;
+
+    // Per company state counts and running totals
+    int64_t num_vtols[MAX_COMPANIES];
+    int64_t num_in_flight[MAX_COMPANIES];
+    int64_t num_charging[MAX_COMPANIES];
+    int64_t num_waiting[MAX_COMPANIES];
+    double total_fly_time_hr[MAX_COMPANIES];
+    double total_charge_time_hr[MAX_COMPANIES];
+    double total_wait_time_hr[MAX_COMPANIES];
+    int64_t total_faults[MAX_COMPANIES];
+
+    // Fault randomization
+    std::default_random_engine rand_gen;
+
+    /**
+     * @brief Add vehicles to a histogram, merging with their bucket's bin
+     *
+     * @param bins - Flight or charge histogram of one company
+     * @param count - Number of vehicles
+     * @param phase_end - Timestamp their phase ends at
+     */
+    void _add_to_bin(std::map<int64_t, AggBin_t>& bins, int64_t count, double phase_end);
+
+    /**
+     * @brief Integrate state counts (and draw faults) up to a timestamp
+     *
+     * @param timestamp - Time to advance to
+     */
+    void _advance_to(double timestamp);
+
+    /**
+     * @brief Start charging a group of vehicles that arrived at the same time
+     *
+     * Chargers are shared between companies in proportion to their counts,
+     * as the agent model serves same-tick arrivals in (random) vehicle order
+     *
+     * @param group - Arrivals per company, modified to those left unserved
+     * @param num_chargers - Chargers available to the group
+     * @return int64_t - Chargers used
+     */
+    int64_t _start_charges(AggWaiting_t& group, int64_t num_chargers);
+
+    /**
+     * @brief Start charging vehicles that just ended a flight, or queue them
+     *
+     * @param arrivals - Arrivals per company
+     */
+    void _arrive_for_charge(AggWaiting_t& arrivals);
+
+    /**
+     * @brief Release chargers, serving waiting vehicles first
+     *
+     * @param count - Number of chargers released
+     */
+    void _release_chargers(int64_t count);
+
+  public:
+    /**
+     * @brief Construct a new Aggregate Sim object
+     *
+     * All vehicles start in flight at t=0, as in FlightSim
+     *
+     * @param company_counts - Number of eVTOLs per company (MAX_COMPANIES entries)
+     * @param num_chargers - Number of chargers
+     * @param bucket_hr - Timing bucket width (e.g. the agent model's tick rate)
+     */
+    AggregateSim(const std::vector<int64_t>& company_counts, int64_t num_chargers, double bucket_hr);
+
+    /**
+     * @brief Seed the fault random generator
+     *
+     * @param seed - Seed value
+     */
+    void seed_faults(unsigned int seed);
+
+    /**
+     * @brief Simulate the fleet for the given amount of time
+     *
+     * @param sim_time_hr - Simulation time in hours
+     */
+    void sim_flight(double sim_time_hr);
+
+    /**
+     * @brief Get aggregated statistics for one company
+     *
+     * @param company - Company designation
+     * @return CompanyStats_t - Same outputs as FlightSim::get_company_stats
+     */
+    CompanyStats_t get_company_stats(VTOL_Comp_e company);
+
+    /**
+     * @brief Print statistics per company, as per FlightSim::aggregate_company_stats
+     */
+    void aggregate_company_stats();
+
+    /**
+     * @brief Print the relative error of each statistic against the agent model
+     *
+     * The agent sim should have run the same company mix and chargers, and
+     * this sim for the agent's get_timestamp(). Also prints fleet-wide hours;
+     * statistics with a zero agent value show the absolute error instead
+     *
+     * @param agent - Agent model (FlightSim) after sim_flight
+     */
+    void display_error(FlightSim& agent);
+
+    /**
+     * @brief Get the number of histogram bins currently in use
+     *
+     * @return size_t - Bins across all companies and states
+     */
+    size_t get_num_bins();
+};
+
+#endif // _AGGREGATE_SIM_
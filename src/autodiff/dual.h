@@ -0,0 +1,100 @@
+/**
+ * @brief Forward-mode dual number for parameter sensitivities
+ *
+ * Carries a value and its partial derivatives with respect to every
+ * (company, parameter) pair, so a single simulation run yields all
+ * sensitivities. Comparisons only use the value, meaning derivatives are
+ * pathwise: discrete events (e.g. charger queue order) are held fixed.
+ *
+ */
+
+#ifndef _DUAL_H_
+#define _DUAL_H_
+
+#include <cmath>
+#include <types.h>
+
+// One derivative direction per company parameter
+#define DUAL_NUM_DIRS (MAX_COMPANIES * MAX_PARAMS)
+
+// Direction index for a given company and parameter
+#define DUAL_DIR(comp, param) ((comp) * MAX_PARAMS + (param))
+
+class Dual {
+  public:
+    float val;                // Value
+    float der[DUAL_NUM_DIRS]; // Partial derivatives
+
+    // Constants have zero derivatives. Implicit so floats promote freely
+    Dual(float val = 0) : val(val) {
+      for (int i = 0; i < DUAL_NUM_DIRS; i++) der[i] = 0;
+    }
+
+    /**
+     * @brief Construct a seeded variable
+     *
+     * @param val - Value
+     * @param dir - Direction index with unit derivative
+     */
+    Dual(float val, int dir) : Dual(val) {
+      der[dir] = 1;
+    }
+
+    Dual& operator+=(const Dual& rhs) {
+      val += rhs.val;
+      for (int i = 0; i < DUAL_NUM_DIRS; i++) der[i] += rhs.der[i];
+      return *this;
+    }
+
+    Dual& operator-=(const Dual& rhs) {
+      val -= rhs.val;
+      for (int i = 0; i < DUAL_NUM_DIRS; i++) der[i] -= rhs.der[i];
+      return *this;
+    }
+
+    Dual& operator*=(const Dual& rhs) {
+      // Product rule, using value before update
+      for (int i = 0; i < DUAL_NUM_DIRS; i++) der[i] = der[i] * rhs.val + val * rhs.der[i];
+      val *= rhs.val;
+      return *this;
+    }
+
+    Dual& operator/=(const Dual& rhs) {
+      // Quotient rule, d(a/b) = (da - (a/b) db) / b. The value is divided
+      // (not multiplied by 1/b) so it rounds exactly as the float sim does
+      float quot = val / rhs.val;
+      for (int i = 0; i < DUAL_NUM_DIRS; i++) der[i] = (der[i] - quot * rhs.der[i]) / rhs.val;
+      val = quot;
+      return *this;
+    }
+
+    Dual operator-() const {
+      Dual out(*this);
+      out.val = -out.val;
+      for (int i = 0; i < DUAL_NUM_DIRS; i++) out.der[i] = -out.der[i];
+      return out;
+    }
+};
+
+inline Dual operator+(Dual lhs, const Dual& rhs) { return lhs += rhs; }
+inline Dual operator-(Dual lhs, const Dual& rhs) { return lhs -= rhs; }
+inline Dual operator*(Dual lhs, const Dual& rhs) { return lhs *= rhs; }
+inline Dual operator/(Dual lhs, const Dual& rhs) { return lhs /= rhs; }
+
+inline bool operator<(const Dual& lhs, const Dual& rhs)  { return lhs.val < rhs.val; }
+inline bool operator>(const Dual& lhs, const Dual& rhs)  { return lhs.val > rhs.val; }
+inline bool operator<=(const Dual& lhs, const Dual& rhs) { return lhs.val <= rhs.val; }
+inline bool operator>=(const Dual& lhs, const Dual& rhs) { return lhs.val >= rhs.val; }
+inline bool operator==(const Dual& lhs, const Dual& rhs) { return lhs.val == rhs.val; }
+inline bool operator!=(const Dual& lhs, const Dual& rhs) { return lhs.val != rhs.val; }
+
+/**
+ * @brief Get the plain value of a scalar, for code shared by all scalar types
+ *
+ * @param x - Scalar
+ * @return float - Value without derivatives
+ */
+inline float scalar_value(float x) { return x; }
+inline float scalar_value(const Dual& x) { return x.val; }
+
+#endif // _DUAL_H_
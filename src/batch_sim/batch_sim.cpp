@@ -0,0 +1,317 @@
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <types.h>
+#include "batch_sim.h"
+
+// Lanes per vector step. 4 x 32-bit is one 128-bit register, which every
+// x86-64 and AArch64 target has; wider vectors get split (or worse,
+// scalarised) unless the whole build targets AVX. GCC/Clang vector
+// extensions keep the kernel explicit SIMD without tying it to one ISA.
+#define KERNEL_WIDTH (4)
+
+typedef float    lane_f __attribute__((vector_size(KERNEL_WIDTH * sizeof(float))));
+typedef int32_t  lane_i __attribute__((vector_size(KERNEL_WIDTH * sizeof(int32_t))));
+typedef uint32_t lane_u __attribute__((vector_size(KERNEL_WIDTH * sizeof(uint32_t))));
+
+// Unaligned lane loads/stores; memcpy compiles down to vector moves
+static inline lane_f load_lane(const float* p)    { lane_f v; memcpy(&v, p, sizeof(v)); return v; }
+static inline lane_i load_lane(const int32_t* p)  { lane_i v; memcpy(&v, p, sizeof(v)); return v; }
+static inline lane_u load_lane(const uint32_t* p) { lane_u v; memcpy(&v, p, sizeof(v)); return v; }
+static inline void store_lane(float* p, lane_f v)    { memcpy(p, &v, sizeof(v)); }
+static inline void store_lane(int32_t* p, lane_i v)  { memcpy(p, &v, sizeof(v)); }
+static inline void store_lane(uint32_t* p, lane_u v) { memcpy(p, &v, sizeof(v)); }
+
+// True if any lane of a mask is set
+static inline bool any_lane(lane_i mask)
+{
+  int32_t bits = 0;
+  for (int i = 0; i < KERNEL_WIDTH; i++) bits |= mask[i];
+  return bits != 0;
+}
+
+BatchScenario_t make_batch_scenario(const std::vector<VTOL_Comp_e>& companies, int num_chargers, float tick_rate, unsigned int seed)
+{
+  BatchScenario_t scenario;
+  scenario.companies    = companies;
+  scenario.num_chargers = num_chargers;
+  scenario.tick_rate    = tick_rate;
+  scenario.seed         = seed;
+  for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+    scenario.params[comp] = COMP_MAP.at(static_cast<VTOL_Comp_e>(comp));
+  }
+  return scenario;
+}
+
+BatchFlightSim::BatchFlightSim(const std::vector<BatchScenario_t>& scenarios)
+{
+  if (scenarios.empty() || scenarios.size() > BATCH_LANES) {
+    throw std::runtime_error("Invalid number of batch scenarios!");
+  }
+  num_lanes = scenarios.size();
+
+  num_slots = 0;
+  for (const BatchScenario_t& scenario : scenarios) {
+    if ((int)scenario.companies.size() > num_slots) num_slots = scenario.companies.size();
+  }
+
+  int size = num_slots * BATCH_LANES;
+  active.assign(size, 0);
+  company.assign(size, 0);
+  state.assign(size, IN_FLIGHT);
+  blocked.assign(size, 0);
+  flight_end.assign(size, 0);
+  charge_end.assign(size, 0);
+  cruise_speed.assign(size, 0);
+  flight_time.assign(size, 0);
+  chg_time.assign(size, 0);
+  fault_thresh.assign(size, 0);
+  rng.assign(size, 1);
+  fly_time.assign(size, 0);
+  fly_dist.assign(size, 0);
+  charge_time.assign(size, 0);
+  wait_time.assign(size, 0);
+  faults.assign(size, 0);
+
+  for (int lane = 0; lane < BATCH_LANES; lane++)
+  {
+    // Unused lanes stay idle with a valid clock
+    timestamp[lane]          = 0;
+    hr_per_tick[lane]        = 1;
+    start_timestamp[lane]    = 0;
+    num_ticks[lane]          = 0;
+    chargers_available[lane] = 0;
+    running[lane]            = 0;
+    wait_q_head[lane]        = 0;
+    wait_q_len[lane]         = 0;
+    wait_q[lane].assign(num_slots, 0);
+
+    if (lane >= num_lanes) continue;
+    const BatchScenario_t& scenario = scenarios[lane];
+
+    if (scenario.tick_rate <= 0) {
+      throw std::runtime_error("Invalid hours-per-tick!");
+    }
+    hr_per_tick[lane]        = scenario.tick_rate;
+    chargers_available[lane] = scenario.num_chargers;
+
+    for (int slot = 0; slot < (int)scenario.companies.size(); slot++)
+    {
+      int k = slot * BATCH_LANES + lane;
+      const VTOLParams_t& params = scenario.params[scenario.companies[slot]];
+
+      active[k]       = 1;
+      company[k]      = scenario.companies[slot];
+      cruise_speed[k] = params.cruise_speed_mph;
+      chg_time[k]     = params.chg_time_hr;
+
+      // Same arithmetic as eVTOL_Sim_T::start_flight
+      float cruise_power_draw_kw = params.energy_use_kwh_per_mi * params.cruise_speed_mph;
+      flight_time[k] = params.battery_capacity_kwh / cruise_power_draw_kw;
+      flight_end[k]  = timestamp[lane] + flight_time[k];
+
+      // Per-tick fault probability as a 32-bit threshold
+      double fault_p  = (double)params.fault_prob_per_hr * scenario.tick_rate;
+      fault_thresh[k] = (uint32_t)fmin(fault_p * 4294967296.0, 4294967295.0);
+
+      // Decorrelate slots; xorshift state must be nonzero
+      uint32_t seed = scenario.seed * 2654435761u + (uint32_t)slot * 40503u + 0x9E3779B9u;
+      rng[k] = (seed == 0) ? 1 : seed;
+    }
+  }
+}
+
+void BatchFlightSim::_start_charge_waiting(int lane, int slot, float release_ts)
+{
+  // Mirrors eVTOL_Sim_T::start_charge for a WAITING_TO_CHARGE eVTOL
+  int k = slot * BATCH_LANES + lane;
+  charge_end[k] = release_ts + chg_time[k];
+
+  float timestamp_diff = timestamp[lane] - release_ts;
+  charge_time[k] += timestamp_diff;
+  if (state[k] == WAITING_TO_CHARGE) wait_time[k] -= timestamp_diff;
+
+  state[k] = CHARGING;
+}
+
+void BatchFlightSim::_tick_kernel()
+{
+  // Per-lane clock tick, only for lanes still running; computed from the
+  // tick count, as per GlobalClk_T::tick
+  for (int lane = 0; lane < BATCH_LANES; lane++) {
+    num_ticks[lane] += running[lane] ? 1 : 0;
+    timestamp[lane]  = hr_per_tick[lane] * (float)num_ticks[lane];
+  }
+
+  const lane_f zero_f = {};
+  const lane_i zero_i = {};
+
+  for (int group = 0; group < BATCH_LANES; group += KERNEL_WIDTH)
+  {
+    const lane_f ts  = load_lane(&timestamp[group]);
+    const lane_f dt  = load_lane(&hr_per_tick[group]);
+    const lane_i run = load_lane(&running[group]) != 0;
+
+    for (int slot = 0; slot < num_slots; slot++)
+    {
+      int base = slot * BATCH_LANES + group;
+
+      // Vector step: one eVTOL per lane, all branches turned into masks
+      // Mirrors FlightSim::_sim_tick -> eVTOL_Sim_T::is_blocked/tick. Adding a
+      // masked-off +0.0 leaves a value unchanged, so every lane is bit-identical
+      // to the scalar path.
+      lane_i curr_state = load_lane(&state[base]);
+      lane_i is_blocked = load_lane(&blocked[base]) != 0;
+      lane_i live       = run & (load_lane(&active[base]) != 0);
+      lane_i blk        = live & is_blocked;
+      lane_i unblk      = live & ~is_blocked;
+      lane_i fly        = unblk & (curr_state == (int32_t)IN_FLIGHT);
+      lane_i chg        = unblk & (curr_state == (int32_t)CHARGING);
+
+      // Blocked: accrue waiting time, corrected once a charger frees up
+      lane_f wait_hr = load_lane(&wait_time[base]) + (blk ? dt : zero_f);
+
+      // IN_FLIGHT: accrue flight, draw fault
+      lane_f cruise = load_lane(&cruise_speed[base]);
+      lane_f fly_hr = load_lane(&fly_time[base]) + (fly ? dt : zero_f);
+      lane_f fly_mi = load_lane(&fly_dist[base]) + (fly ? cruise * dt : zero_f);
+
+      lane_u rng_prev = load_lane(&rng[base]);
+      lane_u x = rng_prev;
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      store_lane(&rng[base], fly ? x : rng_prev);
+      // Masks are -1 where set, so subtracting counts a fault
+      store_lane(&faults[base], load_lane(&faults[base]) - (fly & (x < load_lane(&fault_thresh[base]))));
+
+      // Flight end: correct overshoot, then try for a charger
+      lane_f fe_ts       = load_lane(&flight_end[base]);
+      lane_i flight_done = fly & (ts >= fe_ts);
+      lane_f flight_diff = ts - fe_ts;
+      fly_hr -= flight_done ? flight_diff : zero_f;
+      fly_mi -= flight_done ? flight_diff * cruise : zero_f;
+
+      lane_i avail = load_lane(&chargers_available[group]);
+      lane_i grant = flight_done & (avail > 0);
+      lane_i wait  = flight_done & ~grant;
+      store_lane(&chargers_available[group], avail + grant);
+
+      lane_f ce_ts     = grant ? fe_ts + load_lane(&chg_time[base]) : load_lane(&charge_end[base]);
+      lane_f charge_hr = load_lane(&charge_time[base]) + (grant ? flight_diff : zero_f);
+      wait_hr += wait ? flight_diff : zero_f;
+
+      // CHARGING: accrue charge time
+      charge_hr += chg ? dt : zero_f;
+
+      // Charge end: correct overshoot, start next flight, release charger
+      lane_i charge_done = chg & (ts >= ce_ts);
+      lane_f charge_diff = ts - ce_ts;
+      charge_hr -= charge_done ? charge_diff : zero_f;
+      fly_hr    += charge_done ? charge_diff : zero_f;
+      fly_mi    += charge_done ? charge_diff * cruise : zero_f;
+      fe_ts      = charge_done ? ce_ts + load_lane(&flight_time[base]) : fe_ts;
+
+      lane_i next_state = grant ? zero_i + (int32_t)CHARGING
+                        : wait ? zero_i + (int32_t)WAITING_TO_CHARGE
+                        : charge_done ? zero_i + (int32_t)IN_FLIGHT
+                        : curr_state;
+
+      store_lane(&state[base], next_state);
+      store_lane(&flight_end[base], fe_ts);
+      store_lane(&charge_end[base], ce_ts);
+      store_lane(&fly_time[base], fly_hr);
+      store_lane(&fly_dist[base], fly_mi);
+      store_lane(&charge_time[base], charge_hr);
+      store_lane(&wait_time[base], wait_hr);
+
+      // Scalar step over lanes that touch the wait queue (rare)
+      if (!any_lane(wait | charge_done)) continue;
+      for (int i = 0; i < KERNEL_WIDTH; i++)
+      {
+        int lane = group + i;
+        if (wait[i]) {
+          int tail = (wait_q_head[lane] + wait_q_len[lane]) % num_slots;
+          wait_q[lane][tail] = slot;
+          ++wait_q_len[lane];
+        }
+
+        if (charge_done[i]) {
+          if (wait_q_len[lane] == 0) {
+            ++chargers_available[lane];
+          } else {
+            int next_slot = wait_q[lane][wait_q_head[lane]];
+            wait_q_head[lane] = (wait_q_head[lane] + 1) % num_slots;
+            --wait_q_len[lane];
+            _start_charge_waiting(lane, next_slot, charge_end[base + i]);
+          }
+        }
+      }
+    }
+  }
+
+  // Update blocked flags after all eVTOLs have processed the tick
+  for (int k = 0; k < num_slots * BATCH_LANES; k += KERNEL_WIDTH) {
+    lane_i waiting = load_lane(&state[k]) == (int32_t)WAITING_TO_CHARGE;
+    store_lane(&blocked[k], waiting & 1);
+  }
+}
+
+void BatchFlightSim::sim_flight(float sim_time_hr)
+{
+  for (int lane = 0; lane < num_lanes; lane++) {
+    start_timestamp[lane] = timestamp[lane];
+    running[lane] = 1;
+  }
+
+  bool any_running = true;
+  while (any_running)
+  {
+    _tick_kernel();
+
+    // Same completion criterion as FlightSim::sim_flight, per lane
+    any_running = false;
+    for (int lane = 0; lane < num_lanes; lane++) {
+      float time_complete_hr = timestamp[lane] - start_timestamp[lane];
+      int pct_complete = (int)roundf(100.0 * (time_complete_hr / sim_time_hr));
+      running[lane] = running[lane] && (pct_complete < 100);
+      any_running = any_running || running[lane];
+    }
+  }
+}
+
+CompanyStats_t BatchFlightSim::get_company_stats(int lane, VTOL_Comp_e comp)
+{
+  CompanyStats_t out = CompanyStats_t();
+
+  for (int slot = 0; slot < num_slots; slot++) {
+    int k = slot * BATCH_LANES + lane;
+    if (active[k] && company[k] == comp) ++out.num_vtols;
+  }
+  if (out.num_vtols == 0) return out;
+
+  // Same accumulation order and arithmetic as compute_company_stats
+  float num_vtols = out.num_vtols;
+  for (int slot = 0; slot < num_slots; slot++)
+  {
+    int k = slot * BATCH_LANES + lane;
+    if (!active[k] || company[k] != comp) continue;
+
+    out.avg_flight_time_hr     += fly_time[k] / num_vtols;
+    out.avg_flight_distance_mi += fly_dist[k] / num_vtols;
+    out.avg_charging_time_hr   += charge_time[k] / num_vtols;
+    out.avg_waiting_time_hr    += wait_time[k] / num_vtols;
+    out.total_faults           += faults[k];
+    out.total_passenger_miles  += fly_dist[k] * (float)VTOL_PASSENGERS.at(comp);
+  }
+  // No importance sampling in batched mode
+  out.weighted_faults = out.total_faults;
+
+  return out;
+}
+
+int BatchFlightSim::get_num_lanes()
+{
+  return num_lanes;
+}
@@ -0,0 +1,134 @@
+/**
+ * Batched flight simulator
+ * 
+ * Packs up to BATCH_LANES independent scenarios (fleet mix, charger count,
+ * tick rate, parameters, fault seed) into the lanes of one tick kernel.
+ * State is stored structure-of-arrays, slot-major, so each eVTOL slot of
+ * all lanes is processed as one branch-free vector step. Charger queueing
+ * is the only divergent step: lanes that enqueue or release are flagged
+ * with masks in the vector step and serviced by a scalar loop afterwards.
+ * 
+ * Each lane follows exactly the same tick ordering and float arithmetic as
+ * FlightSim, so non-random statistics match a FlightSim run of the same
+ * scenario. Faults use a per-vehicle xorshift generator instead of the
+ * standard library distributions, so fault counts differ run to run.
+ */
+
+#ifndef _BATCH_SIM_
+#define _BATCH_SIM_
+
+#include <cstdint>
+#include <vector>
+#include <types.h>
+
+// Number of scenarios per kernel (processed as 128-bit vector steps)
+#define BATCH_LANES (8)
+
+// Description of one scenario
+typedef struct BatchScenario_t {
+  std::vector<VTOL_Comp_e> companies;    // Company of each eVTOL (fleet mix)
+  VTOLParams_t params[MAX_COMPANIES];    // Parameters per company
+  int num_chargers;                      // Number of chargers
+  float tick_rate;                       // Hours passed per tick
+  unsigned int seed;                     // Fault generator seed
+} BatchScenario_t;
+
+/**
+ * @brief Build a scenario using the default company parameters
+ * 
+ * @param companies - Company of each eVTOL
+ * @param num_chargers - Number of chargers
+ * @param tick_rate - Hours passed per tick
+ * @param seed - Fault generator seed
+ * @return BatchScenario_t - Scenario description
+ */
+BatchScenario_t make_batch_scenario(const std::vector<VTOL_Comp_e>& companies, int num_chargers, float tick_rate, unsigned int seed);
+
+class BatchFlightSim {
+  private:
+    int num_lanes;  // Scenarios in use
+    int num_slots;  // eVTOL slots per lane (largest fleet)
+
+    // Per-lane clock, charger and run state
+    float   timestamp[BATCH_LANES];
+    float   hr_per_tick[BATCH_LANES];
+    float   start_timestamp[BATCH_LANES];
+    int64_t num_ticks[BATCH_LANES];   // Ticks since t=0, as per GlobalClk_T
+    int32_t chargers_available[BATCH_LANES];
+    int32_t running[BATCH_LANES];
+
+    // Per-lane FIFO charger wait queues (ring buffers of slot indices)
+    std::vector<int32_t> wait_q[BATCH_LANES];
+    int32_t wait_q_head[BATCH_LANES];
+    int32_t wait_q_len[BATCH_LANES];
+
+    // Per-eVTOL state, indexed slot * BATCH_LANES + lane
+    std::vector<int32_t>  active;         // Slot holds an eVTOL in this lane
+    std::vector<int32_t>  company;
+    std::vector<int32_t>  state;
+    std::vector<int32_t>  blocked;
+    std::vector<float>    flight_end;
+    std::vector<float>    charge_end;
+    std::vector<float>    cruise_speed;
+    std::vector<float>    flight_time;
+    std::vector<float>    chg_time;
+    std::vector<uint32_t> fault_thresh;   // Fault if draw < threshold
+    std::vector<uint32_t> rng;            // xorshift32 state
+
+    // Per-eVTOL statistics, same layout
+    std::vector<float>   fly_time;
+    std::vector<float>   fly_dist;
+    std::vector<float>   charge_time;
+    std::vector<float>   wait_time;
+    std::vector<int32_t> faults;
+
+    /**
+     * @brief Advance all running lanes by one tick
+     */
+    void _tick_kernel();
+
+    /**
+     * @brief Start charging a waiting eVTOL released a charger (scalar path)
+     * 
+     * @param lane - Lane index
+     * @param slot - Slot of the eVTOL to start charging
+     * @param release_ts - Timestamp the charger was released at
+     */
+    void _start_charge_waiting(int lane, int slot, float release_ts);
+
+  public:
+    /**
+     * @brief Construct a new Batch Flight Sim object
+     * 
+     * @param scenarios - Up to BATCH_LANES scenarios
+     */
+    BatchFlightSim(const std::vector<BatchScenario_t>& scenarios);
+
+    /**
+     * @brief Simulate every lane for the given amount of time
+     * 
+     * Lanes with coarser ticks finish first and are masked off while the
+     * rest complete.
+     * 
+     * @param sim_time_hr - Simulation time in hours
+     */
+    void sim_flight(float sim_time_hr);
+
+    /**
+     * @brief Get aggregated statistics for one company in one lane
+     * 
+     * @param lane - Lane (scenario) index
+     * @param comp - Company designation
+     * @return CompanyStats_t - Averages and totals, as per FlightSim
+     */
+    CompanyStats_t get_company_stats(int lane, VTOL_Comp_e comp);
+
+    /**
+     * @brief Get the number of scenarios in use
+     * 
+     * @return int - Number of lanes
+     */
+    int get_num_lanes();
+};
+
+#endif // _BATCH_SIM_
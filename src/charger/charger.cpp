@@ -1,14 +1,19 @@
 #include "charger.h"
 #include <evtol_sim.h>
+#include <dual.h>
 #include <deque>
+#include <stdexcept>
 
-Charger::Charger(int num_chargers)
+template <typename T>
+Charger_T<T>::Charger_T(int num_chargers)
 {
   // Instantiate number of chargers
+  this->num_chargers = num_chargers;
   chargers_available = num_chargers;
 }
 
-bool Charger::try_get_charger(eVTOL_Sim* vtol_ptr)
+template <typename T>
+bool Charger_T<T>::try_get_charger(eVTOL_Sim_T<T>* vtol_ptr)
 {
   // Act based on number of chargers available
   if (chargers_available > 0)
@@ -23,7 +28,8 @@ bool Charger::try_get_charger(eVTOL_Sim* vtol_ptr)
   return false;
 }
 
-void Charger::release_charger(float timestamp)
+template <typename T>
+void Charger_T<T>::release_charger(T timestamp)
 {
   if (wait_q.empty())
   {
@@ -33,10 +39,54 @@ void Charger::release_charger(float timestamp)
   else
   {
     // Get the most recent waiting VTOL from the wait queue
-    eVTOL_Sim* vtol = wait_q.front();
+    eVTOL_Sim_T<T>* vtol = wait_q.front();
     // Unblock VTOL by calling it's "start_charge" method
     vtol->start_charge(timestamp);
     // Pop from the queue
     wait_q.pop_front();
   }
-}
\ No newline at end of file
+}
+
+template <typename T>
+int Charger_T<T>::get_chargers_in_use()
+{
+  return num_chargers - chargers_available;
+}
+
+template <typename T>
+int Charger_T<T>::get_num_chargers()
+{
+  return num_chargers;
+}
+
+template <typename T>
+int Charger_T<T>::get_wait_q_len()
+{
+  return wait_q.size();
+}
+
+template <typename T>
+void Charger_T<T>::set_chargers_in_use(int in_use)
+{
+  if (!wait_q.empty() || in_use < 0 || in_use > num_chargers) {
+    throw std::runtime_error("Invalid charger occupancy!");
+  }
+  chargers_available = num_chargers - in_use;
+}
+
+template <typename T>
+void Charger_T<T>::set_power_timeline(std::shared_ptr<PowerTimeline> timeline)
+{
+  power_timeline = timeline;
+}
+
+template <typename T>
+void Charger_T<T>::record_session(T start_timestamp, T end_timestamp, T power_kw)
+{
+  if (power_timeline == nullptr) return;
+  power_timeline->add_session(scalar_value(start_timestamp), scalar_value(end_timestamp), scalar_value(power_kw));
+}
+
+// Explicit instantiations for supported scalar types
+template class Charger_T<float>;
+template class Charger_T<Dual>;
\ No newline at end of file
@@ -9,15 +9,21 @@
 #define _CHARGER_H_
 
 #include <deque>
+#include <memory>
 #include <evtol_sim.h>
+#include <power_timeline.h>
 
 // Included here due to circular dependency
-typedef class eVTOL_Sim;
+template <typename T> class eVTOL_Sim_T;
 
-class Charger {
+// Templated over scalar type; instantiated for float and Dual
+template <typename T>
+class Charger_T {
   private:
+    int num_chargers;       // Total number of chargers
     int chargers_available; // Counter for number of chargers available
-    std::deque<eVTOL_Sim *> wait_q; // Wait queue for VTOLs
+    std::deque<eVTOL_Sim_T<T> *> wait_q; // Wait queue for VTOLs
+    std::shared_ptr<PowerTimeline> power_timeline; // Power draw record, null if disabled
 
   public:
     /**
@@ -25,7 +31,7 @@ class Charger {
      * 
      * @param num_chargers - Number of chargers available
      */
-    Charger(int num_chargers);
+    Charger_T(int num_chargers);
     
     /**
      * @brief Attempt to get a charger
@@ -34,7 +40,7 @@ class Charger {
      * @return true - If charger is available
      * @return false - If charger is not available. Also added to internal wait queue
      */
-    bool try_get_charger(eVTOL_Sim* vtol_ptr);
+    bool try_get_charger(eVTOL_Sim_T<T>* vtol_ptr);
 
     /**
      * @brief Release a charger
@@ -43,7 +49,59 @@ class Charger {
      * 
      * @param timestamp - Timestamp of charger release, passed from releasing VTOL
      */
-    void release_charger(float timestamp);
+    void release_charger(T timestamp);
+
+    /**
+     * @brief Get the number of chargers currently in use
+     * 
+     * @return int - Chargers in use
+     */
+    int get_chargers_in_use();
+
+    /**
+     * @brief Get the total number of chargers
+     * 
+     * @return int - Chargers in pool
+     */
+    int get_num_chargers();
+
+    /**
+     * @brief Get the number of VTOLs waiting for a charger
+     * 
+     * @return int - Wait queue length
+     */
+    int get_wait_q_len();
+
+    /**
+     * @brief Force the number of chargers in use
+     * 
+     * Used after fast-forwarding, where charger holds are predicted rather
+     * than requested. Only valid while no VTOL is waiting.
+     * 
+     * @param in_use - Chargers in use
+     */
+    void set_chargers_in_use(int in_use);
+
+    /**
+     * @brief Record charging sessions into a power-draw timeline
+     * 
+     * @param timeline - Timeline to record into (null to disable)
+     */
+    void set_power_timeline(std::shared_ptr<PowerTimeline> timeline);
+
+    /**
+     * @brief Record a charging session, if a power timeline is set
+     * 
+     * Called by a VTOL as it starts charging, whether it got a charger
+     * directly or was released from the wait queue
+     * 
+     * @param start_timestamp - Session start (in hours)
+     * @param end_timestamp - Session end (in hours)
+     * @param power_kw - Constant power drawn
+     */
+    void record_session(T start_timestamp, T end_timestamp, T power_kw);
 };
 
+typedef Charger_T<float> Charger;
+
 #endif // _CHARGER_
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * @brief Per-company statistics aggregation, shared by all scalar types
+ * 
+ */
+
+#ifndef _COMPANY_STATS_H_
+#define _COMPANY_STATS_H_
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <types.h>
+#include <evtol_sim.h>
+
+/**
+ * @brief Aggregate statistics over all eVTOLs of one company
+ * 
+ * @tparam T - Scalar type of the simulation
+ * @param company - Company designation
+ * @param vtols - All eVTOL instances of that company
+ * @return CompanyStats_T<T> - Averages and totals for the company
+ */
+template <typename T>
+CompanyStats_T<T> compute_company_stats(VTOL_Comp_e company, const std::vector<std::shared_ptr<eVTOL_Sim_T<T>>>& vtols)
+{
+  // Instantiate running statistics for company
+  CompanyStats_T<T> out = CompanyStats_T<T>();
+  out.num_vtols = vtols.size();
+
+  // For averages
+  float num_vtols = vtols.size();
+
+  // Iterate over all eVTOLs of company make
+  for (std::shared_ptr<eVTOL_Sim_T<T>> vtol_p : vtols)
+  {
+    VTOLStats_T<T>* stats_p = vtol_p->get_stats_ptr();
+    // Averages
+    out.avg_flight_time_hr += stats_p->vehicle_fly_time_hr / num_vtols;
+    out.avg_flight_distance_mi += stats_p->vehicle_fly_distance_mi / num_vtols;
+    out.avg_charging_time_hr += stats_p->total_charge_time_hr / num_vtols;
+    out.avg_waiting_time_hr += stats_p->charge_wait_time_hr / num_vtols;
+    // Totals
+    out.total_faults += stats_p->num_faults;
+    out.weighted_faults += stats_p->num_faults * exp(stats_p->fault_log_weight);
+    out.total_passenger_miles += stats_p->vehicle_fly_distance_mi * (float)VTOL_PASSENGERS.at(company);
+  }
+
+  return out;
+}
+
+/**
+ * @brief Print one company's statistics block, as per the spec
+ * 
+ * @param company - Company designation
+ * @param stats - Aggregated statistics for the company
+ * @param show_weighted - Also print likelihood-ratio weighted faults
+ */
+inline void display_company_stats(VTOL_Comp_e company, const CompanyStats_t& stats, bool show_weighted)
+{
+  std::cout << COMP_NAMES.at(company) << " Statistics:" << std::endl;
+  std::cout << "\tAvg. Flight Time:      " << stats.avg_flight_time_hr << " hours" << std::endl;
+  std::cout << "\tAvg. Flight Distance:  " << stats.avg_flight_distance_mi << " miles" << std::endl;
+  std::cout << "\tAvg. Charging Time:    " << stats.avg_charging_time_hr << " hours" << std::endl;
+  std::cout << "\tTotal Faults:          " << stats.total_faults << std::endl;
+  if (show_weighted) {
+    std::cout << "\tWeighted Faults:       " << stats.weighted_faults << std::endl;
+  }
+  std::cout << "\tTotal Passenger Miles: " << stats.total_passenger_miles << std::endl;
+  std::cout << "\tAvg. Waiting Time:     " << stats.avg_waiting_time_hr << " hours" << std::endl;
+  std::cout << std::endl; // Extra line break between company stats blocks
+}
+
+#endif // _COMPANY_STATS_H_
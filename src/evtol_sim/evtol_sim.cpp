@@ -1,45 +1,65 @@
 #include <iostream>
+#include <cmath>
 #include <random>
+#include <stdexcept>
 #include <types.h>
+#include <dual.h>
 #include <global_clk.h>
 #include <charger.h>
+#include <maintenance_bay.h>
 
 #include "evtol_sim.h"
 
-eVTOL_Sim::eVTOL_Sim(VTOL_Comp_e company, std::shared_ptr<GlobalClk> clk, std::shared_ptr<Charger> charger) {
+template <typename T>
+eVTOL_Sim_T<T>::eVTOL_Sim_T(VTOL_Comp_e company, std::shared_ptr<GlobalClk_T<T>> clk, std::shared_ptr<Charger_T<T>> charger)
   // Copy in parameters using company enum
+  : eVTOL_Sim_T(company, convert_params<T>(COMP_MAP.at(company)), clk, charger) {}
+
+template <typename T>
+eVTOL_Sim_T<T>::eVTOL_Sim_T(VTOL_Comp_e company, const VTOLParams_T<T>& params, std::shared_ptr<GlobalClk_T<T>> clk, std::shared_ptr<Charger_T<T>> charger) {
+  // Copy in parameters
   this->company = company;
-  memcpy(&this->params, &(COMP_MAP.at(company)), sizeof(VTOLParams_t));
+  this->params  = params;
   // Assign local clock and charger pointers
   this->clk = clk;
   this->charger = charger;
 
   // Initialize statistics to all zeros
-  this->stats = {0, 0, 0, 0, 0};
+  this->stats = VTOLStats_T<T>();
 
   // Initialize fault bernoulli distribution to fault per hour x hour per tick
   // Assumes uniform probability distribution per hour and hr_per_tick <= 1
   // TODO: is this a correct assumption? Could also be a Poisson distribution
-  fault_dist = std::bernoulli_distribution(this->params.fault_prob_per_hr * this->clk->get_hr_per_tick());
+  // Derivatives can't pass through a random draw, so only the value is used
+  fault_dist = std::bernoulli_distribution(scalar_value(this->params.fault_prob_per_hr * this->clk->get_hr_per_tick()));
+  // Untilted by default, so draws carry no weight
+  fault_log_lr_hit  = 0;
+  fault_log_lr_miss = 0;
 
   // Clear blocked flag. Will be set on tick call
   this->blocked = false;
 
+  // Faults have no consequence unless a maintenance bay pool is set
+  flight_faults           = 0;
+  grounded_sync_timestamp = this->clk->get_timestamp();
+
   // Start a flight
   start_flight(this->clk->get_timestamp());
 }
 
-void eVTOL_Sim::start_flight(float timestamp) {
-  // Flight time will be hours to battery depletion, or
-  // battery capacity / cruise power draw 
-  // Where cruise power draw is energy draw per mile x cruise speed (mph)
-  float cruise_power_draw_kw = params.energy_use_kwh_per_mi * params.cruise_speed_mph;
-  float flight_time_hr = params.battery_capacity_kwh / cruise_power_draw_kw;
+template <typename T>
+void eVTOL_Sim_T<T>::start_flight(T timestamp) {
+  _start_flight(timestamp, clk->get_timestamp());
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::_start_flight(T timestamp, T curr_timestamp) {
   // Set flight time end as timestamp + flight time hr
-  flight_end_timestamp = timestamp + flight_time_hr;
+  flight_end_timestamp = timestamp + get_flight_time_hr();
+  flight_faults        = 0;
 
   // Update stats based on start time and current timestamp
-  float timestamp_diff = clk->get_timestamp() - timestamp;
+  T timestamp_diff = curr_timestamp - timestamp;
   stats.vehicle_fly_time_hr += timestamp_diff;
   stats.vehicle_fly_distance_mi += timestamp_diff * params.cruise_speed_mph;
 
@@ -47,12 +67,21 @@ void eVTOL_Sim::start_flight(float timestamp) {
   curr_state = IN_FLIGHT;
 }
 
-void eVTOL_Sim::start_charge(float timestamp) {
+template <typename T>
+void eVTOL_Sim_T<T>::start_charge(T timestamp) {
+  _start_charge(timestamp, clk->get_timestamp());
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::_start_charge(T timestamp, T curr_timestamp) {
   // Set charge end time to timestamp + charge time
   charge_end_timestamp = timestamp + params.chg_time_hr;
 
+  // A full charge at constant power over the whole session
+  charger->record_session(timestamp, charge_end_timestamp, params.battery_capacity_kwh / params.chg_time_hr);
+
   // Update stats based on start time and current timestamp
-  float timestamp_diff = clk->get_timestamp() - timestamp;
+  T timestamp_diff = curr_timestamp - timestamp;
   stats.total_charge_time_hr += timestamp_diff;
 
   // If previously blocked, correct charge wait time by difference
@@ -64,29 +93,96 @@ void eVTOL_Sim::start_charge(float timestamp) {
   curr_state = CHARGING;
 }
 
-void eVTOL_Sim::_check_fault() {
+template <typename T>
+void eVTOL_Sim_T<T>::_check_fault() {
   // Use bernoulli distribution to increment counter
-  if (fault_dist(rand_gen)) ++stats.num_faults;
+  // Accumulate likelihood ratio of the draw (zero unless tilted)
+  if (fault_dist(rand_gen)) {
+    ++stats.num_faults;
+    ++flight_faults;
+    stats.fault_log_weight += fault_log_lr_hit;
+  } else {
+    stats.fault_log_weight += fault_log_lr_miss;
+  }
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::_check_faults(int64_t num_ticks) {
+  if (num_ticks == 1) {
+    _check_fault();
+    return;
+  }
+
+  // Sum of num_ticks bernoulli draws, each carrying its likelihood ratio
+  std::binomial_distribution<int64_t> batch_dist(num_ticks, fault_dist.p());
+  int64_t hits = batch_dist(rand_gen);
+  stats.num_faults += hits;
+  flight_faults    += hits;
+  stats.fault_log_weight += hits * fault_log_lr_hit + (num_ticks - hits) * fault_log_lr_miss;
+}
+
+template <typename T>
+bool eVTOL_Sim_T<T>::_try_ground(T timestamp, T curr_timestamp) {
+  if (maintenance == nullptr || !maintenance->should_ground(flight_faults)) return false;
+
+  curr_state = WAITING_FOR_MAINTENANCE;
+  ++stats.num_groundings;
+  stats.maintenance_wait_time_hr += curr_timestamp - timestamp;
+  grounded_sync_timestamp = curr_timestamp;
+  maintenance->request_bay(this, timestamp);
+  return true;
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::seed_faults(unsigned int seed) {
+  rand_gen.seed(seed);
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::set_fault_importance_rate(float tilted_prob_per_hr, bool sample_tilted) {
+  double hr_per_tick = scalar_value(clk->get_hr_per_tick());
+  double true_p = scalar_value(params.fault_prob_per_hr) * hr_per_tick;
+  double tilt_p = (tilted_prob_per_hr > 0) ? tilted_prob_per_hr * hr_per_tick : true_p;
+
+  // Sampling probability must stay a valid, non-certain bernoulli parameter
+  if (tilt_p >= 1) {
+    throw std::runtime_error("Tilted fault probability per tick must be < 1!");
+  }
+
+  fault_dist        = std::bernoulli_distribution(sample_tilted ? tilt_p : true_p);
+  fault_log_lr_hit  = log(true_p / tilt_p);
+  fault_log_lr_miss = log1p(-true_p) - log1p(-tilt_p);
 }
 
-bool eVTOL_Sim::is_blocked() {
-  // Increment "waiting to charge" time here by tick
+template <typename T>
+bool eVTOL_Sim_T<T>::is_blocked() {
+  // Increment "waiting to charge" (or maintenance) time here by tick
   // Will be corrected when unblocked
-  if (blocked) stats.charge_wait_time_hr += clk->get_hr_per_tick();
+  if (blocked) {
+    switch (curr_state) {
+      case WAITING_FOR_MAINTENANCE: stats.maintenance_wait_time_hr += clk->get_hr_per_tick(); break;
+      case IN_MAINTENANCE:          stats.maintenance_time_hr      += clk->get_hr_per_tick(); break;
+      default:                      stats.charge_wait_time_hr      += clk->get_hr_per_tick(); break;
+    }
+    grounded_sync_timestamp = clk->get_timestamp();
+  }
   // Return whether VTOL is waiting or not
   return blocked;
 }
 
-void eVTOL_Sim::check_blocked() {
-  // Mark as blocked if after FSM processing VTOL is in "waiting" state
-  blocked = (curr_state == WAITING_TO_CHARGE);
+template <typename T>
+void eVTOL_Sim_T<T>::check_blocked() {
+  // Mark as blocked if after FSM processing VTOL is waiting or grounded.
+  // Grounded VTOLs are moved on by the maintenance bay pool
+  blocked = (curr_state != IN_FLIGHT && curr_state != CHARGING);
 }
 
-void eVTOL_Sim::tick() {
+template <typename T>
+void eVTOL_Sim_T<T>::tick() {
   // Start by getting the current timestamp and hr_per_tick
-  float curr_timestamp = clk->get_timestamp();
-  float hr_per_tick    = clk->get_hr_per_tick();
-  float timestamp_diff; // For timestamp correction later on
+  T curr_timestamp = clk->get_timestamp();
+  T hr_per_tick    = clk->get_hr_per_tick();
+  T timestamp_diff; // For timestamp correction later on
 
   // Enter state machine
   switch (curr_state) {
@@ -109,7 +205,10 @@ void eVTOL_Sim::tick() {
       // for mid-sim checking of distance flown (if desired)
       timestamp_diff                 = curr_timestamp - flight_end_timestamp;
       stats.vehicle_fly_time_hr     -= timestamp_diff;
-      stats.vehicle_fly_distance_mi -= timestamp_diff * hr_per_tick;
+      stats.vehicle_fly_distance_mi -= timestamp_diff * params.cruise_speed_mph;
+
+      // A faulty flight may ground the VTOL until serviced
+      if (_try_ground(flight_end_timestamp, curr_timestamp)) break;
 
       // Try to get charger key, passing pointer to this instance
       if (charger->try_get_charger(this)) {
@@ -152,17 +251,151 @@ void eVTOL_Sim::tick() {
       throw std::runtime_error("Should not process tick while WAITING!");
       break;
 
+    case WAITING_FOR_MAINTENANCE:
+    case IN_MAINTENANCE:
+      // Likewise, moved on by the maintenance bay pool
+      throw std::runtime_error("Should not process tick while grounded!");
+      break;
+
     default:
       throw std::runtime_error("Reached undefined state!");
   }
 }
 
-VTOL_Comp_e eVTOL_Sim::get_company()
+template <typename T>
+void eVTOL_Sim_T<T>::fast_forward(int64_t num_ticks) {
+  if (curr_state != IN_FLIGHT && curr_state != CHARGING) {
+    throw std::runtime_error("Can't fast-forward while WAITING or grounded!");
+  }
+
+  T hr_per_tick = clk->get_hr_per_tick();
+  int64_t tick = 0; // Ticks processed so far
+
+  // One iteration per phase, rather than per tick. Phase ends are detected
+  // on the first tick at or past them, one transition per tick, as per tick()
+  while (tick < num_ticks)
+  {
+    T phase_end_timestamp = get_phase_end_timestamp();
+    int64_t end_tick = clk->ticks_until(phase_end_timestamp);
+    if (end_tick <= tick) end_tick = tick + 1;
+
+    // Whole ticks spent in the current phase
+    int64_t phase_ticks = ((end_tick < num_ticks) ? end_tick : num_ticks) - tick;
+    T phase_hr = hr_per_tick * (float)phase_ticks;
+    tick += phase_ticks;
+
+    if (curr_state == IN_FLIGHT) {
+      stats.vehicle_fly_time_hr += phase_hr;
+      stats.vehicle_fly_distance_mi += params.cruise_speed_mph * phase_hr;
+      _check_faults(phase_ticks);
+    } else {
+      stats.total_charge_time_hr += phase_hr;
+    }
+
+    if (tick < end_tick) break;
+
+    // Phase ended on this tick: same corrections as tick(), with the
+    // charger always granted
+    T curr_timestamp = clk->get_tick_timestamp(tick);
+    T timestamp_diff = curr_timestamp - phase_end_timestamp;
+    if (curr_state == IN_FLIGHT) {
+      stats.vehicle_fly_time_hr     -= timestamp_diff;
+      stats.vehicle_fly_distance_mi -= timestamp_diff * params.cruise_speed_mph;
+      // Grounded VTOLs stay put until the bay pool releases them
+      if (_try_ground(phase_end_timestamp, curr_timestamp)) return;
+      _start_charge(phase_end_timestamp, curr_timestamp);
+    } else {
+      stats.total_charge_time_hr -= timestamp_diff;
+      _start_flight(phase_end_timestamp, curr_timestamp);
+    }
+  }
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::start_maintenance(T timestamp) {
+  // Bays are assigned after this tick's FSM processing, so move the time
+  // since service start from waiting to servicing
+  sync_grounded_time();
+  T timestamp_diff = clk->get_timestamp() - timestamp;
+  stats.maintenance_wait_time_hr -= timestamp_diff;
+  stats.maintenance_time_hr      += timestamp_diff;
+
+  curr_state = IN_MAINTENANCE;
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::end_maintenance(T timestamp) {
+  // Correct service time by difference, as per tick()
+  sync_grounded_time();
+  T curr_timestamp = clk->get_timestamp();
+  T timestamp_diff = curr_timestamp - timestamp;
+  stats.maintenance_time_hr -= timestamp_diff;
+
+  // Battery is still depleted from the last flight
+  if (charger->try_get_charger(this)) {
+    _start_charge(timestamp, curr_timestamp);
+  } else {
+    curr_state = WAITING_TO_CHARGE;
+    stats.charge_wait_time_hr += timestamp_diff;
+  }
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::sync_grounded_time() {
+  T curr_timestamp = clk->get_timestamp();
+  if (curr_state == WAITING_FOR_MAINTENANCE) {
+    stats.maintenance_wait_time_hr += curr_timestamp - grounded_sync_timestamp;
+  } else if (curr_state == IN_MAINTENANCE) {
+    stats.maintenance_time_hr += curr_timestamp - grounded_sync_timestamp;
+  }
+  grounded_sync_timestamp = curr_timestamp;
+}
+
+template <typename T>
+void eVTOL_Sim_T<T>::set_maintenance_bay(std::shared_ptr<MaintenanceBay_T<T>> maintenance) {
+  this->maintenance = maintenance;
+}
+
+template <typename T>
+VTOL_Comp_e eVTOL_Sim_T<T>::get_company()
 {
   return this->company;
 }
 
-VTOLStats_t* eVTOL_Sim::get_stats_ptr()
+template <typename T>
+VTOL_State_e eVTOL_Sim_T<T>::get_state()
+{
+  return this->curr_state;
+}
+
+template <typename T>
+T eVTOL_Sim_T<T>::get_phase_end_timestamp()
+{
+  return (curr_state == IN_FLIGHT) ? flight_end_timestamp : charge_end_timestamp;
+}
+
+template <typename T>
+T eVTOL_Sim_T<T>::get_flight_time_hr()
+{
+  // Flight time will be hours to battery depletion, or
+  // battery capacity / cruise power draw 
+  // Where cruise power draw is energy draw per mile x cruise speed (mph)
+  T cruise_power_draw_kw = params.energy_use_kwh_per_mi * params.cruise_speed_mph;
+  return params.battery_capacity_kwh / cruise_power_draw_kw;
+}
+
+template <typename T>
+T eVTOL_Sim_T<T>::get_chg_time_hr()
+{
+  return params.chg_time_hr;
+}
+
+template <typename T>
+VTOLStats_T<T>* eVTOL_Sim_T<T>::get_stats_ptr()
 {
   return &(this->stats);
-}
\ No newline at end of file
+}
+
+// Explicit instantiations for supported scalar types
+template class eVTOL_Sim_T<float>;
+template class eVTOL_Sim_T<Dual>;
\ No newline at end of file
@@ -1,40 +1,52 @@
 #ifndef _VTOL_SIM_
 #define _VTOL_SIM_
 
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <types.h>
 #include <global_clk.h>
 #include <charger.h>
+#include <maintenance_bay.h>
 
 // Included here due to circular dependency
-typedef class Charger;
+template <typename T> class Charger_T;
+template <typename T> class MaintenanceBay_T;
 
 // Class prototype
-class eVTOL_Sim {
+// Templated over scalar type; instantiated for float and Dual
+template <typename T>
+class eVTOL_Sim_T {
   private:
     // Company-specific parameters
     VTOL_Comp_e  company;
-    VTOLParams_t params;
+    VTOLParams_T<T> params;
 
     // Fault randomization
     std::default_random_engine rand_gen;
     std::bernoulli_distribution fault_dist;
+    double fault_log_lr_hit;  // Log likelihood ratio per fault (importance sampling)
+    double fault_log_lr_miss; // Log likelihood ratio per fault-free tick (importance sampling)
 
     // Statistics
-    VTOLStats_t stats;
+    VTOLStats_T<T> stats;
 
     // FSM state
     VTOL_State_e curr_state;
-    float flight_end_timestamp; // Flight is complete
-    float charge_end_timestamp; // Charging is complete
-    bool blocked; // VTOL currently blocked (waiting on charger)
+    T flight_end_timestamp; // Flight is complete
+    T charge_end_timestamp; // Charging is complete
+    bool blocked; // VTOL currently blocked (waiting on charger, or grounded)
+    int flight_faults; // Faults during the current (or last) flight
+    T grounded_sync_timestamp; // Grounded time is accrued up to here
 
     // Clock pointer
-    std::shared_ptr<GlobalClk> clk;
+    std::shared_ptr<GlobalClk_T<T>> clk;
 
     // Charger pointer
-    std::shared_ptr<Charger> charger;
+    std::shared_ptr<Charger_T<T>> charger;
+
+    // Maintenance bay pointer, null if faults don't ground VTOLs
+    std::shared_ptr<MaintenanceBay_T<T>> maintenance;
 
     // Internal methods
 
@@ -42,10 +54,57 @@ class eVTOL_Sim {
      * Check if a fault has occurred in the last hour. Should only be called if tick count has hit an hour mark
      */
     void _check_fault();
+
+    /**
+     * @brief Draw faults for several flight ticks at once
+     * 
+     * Same distribution (and likelihood ratio) as num_ticks _check_fault calls
+     * 
+     * @param num_ticks - Flight ticks to draw for
+     */
+    void _check_faults(int64_t num_ticks);
+
+    /**
+     * @brief Start flight, correcting stats up to the given current timestamp
+     * 
+     * @param timestamp - Time (in hr) when flight begins
+     * @param curr_timestamp - Timestamp of the tick processing the transition
+     */
+    void _start_flight(T timestamp, T curr_timestamp);
+
+    /**
+     * @brief Enter charging state, correcting stats up to the given current timestamp
+     * 
+     * @param timestamp - Time (in hr) when charging begins
+     * @param curr_timestamp - Timestamp of the tick processing the transition
+     */
+    void _start_charge(T timestamp, T curr_timestamp);
+
+    /**
+     * @brief Ground the VTOL at a flight end if its faults call for it
+     * 
+     * @param timestamp - Time (in hr) the flight ended
+     * @param curr_timestamp - Timestamp of the tick processing the landing
+     * @return true - If grounded and queued for a bay
+     * @return false - If it can go on to charge (or no bay pool is set)
+     */
+    bool _try_ground(T timestamp, T curr_timestamp);
   
   public:
-    // Constructor
-    eVTOL_Sim(VTOL_Comp_e company, std::shared_ptr<GlobalClk> clk, std::shared_ptr<Charger> charger);
+    // Constructor, using company parameters from COMP_MAP
+    eVTOL_Sim_T(VTOL_Comp_e company, std::shared_ptr<GlobalClk_T<T>> clk, std::shared_ptr<Charger_T<T>> charger);
+
+    /**
+     * @brief Construct a new eVTOL sim with explicit parameters
+     * 
+     * Used to seed derivative directions when T is a dual number
+     * 
+     * @param company - Company designation (for stats aggregation)
+     * @param params - Vehicle parameters
+     * @param clk - Global clock
+     * @param charger - Charger pool
+     */
+    eVTOL_Sim_T(VTOL_Comp_e company, const VTOLParams_T<T>& params, std::shared_ptr<GlobalClk_T<T>> clk, std::shared_ptr<Charger_T<T>> charger);
 
     /**
      * @brief Start flight
@@ -54,20 +113,49 @@ class eVTOL_Sim {
      * 
      * @param timestamp - Time (in hr) when flight begins
      */
-    void start_flight(float timestamp);
+    void start_flight(T timestamp);
 
     /**
      * @brief Enter charging state
 
      * @param timestamp - Time (in hr) when charging begins
      */
-    void start_charge(float timestamp);
+    void start_charge(T timestamp);
+
+    /**
+     * @brief Enter maintenance, called by the maintenance bay pool
+     * 
+     * @param timestamp - Time (in hr) when service begins
+     */
+    void start_maintenance(T timestamp);
+
+    /**
+     * @brief Leave maintenance and request a charger, called by the maintenance bay pool
+     * 
+     * @param timestamp - Time (in hr) when service ended
+     */
+    void end_maintenance(T timestamp);
+
+    /**
+     * @brief Ground this VTOL after faulty flights, per the given bay pool
+     * 
+     * @param maintenance - Maintenance bay pool (null to disable)
+     */
+    void set_maintenance_bay(std::shared_ptr<MaintenanceBay_T<T>> maintenance);
+
+    /**
+     * @brief Accrue grounded time up to the clock's current timestamp
+     * 
+     * Detailed ticks keep it current; needed after fast-forwarding, which
+     * skips the per-tick accrual of grounded VTOLs
+     */
+    void sync_grounded_time();
 
     /**
-     * @brief Indicate if VTOL is blocked (waiting for a charger)
+     * @brief Indicate if VTOL is blocked (waiting for a charger, or grounded)
      * 
-     * @return true - VTOL is in WAITING state 
-     * @return false - VTOL is not in WAITING state
+     * @return true - VTOL is in a WAITING or maintenance state 
+     * @return false - VTOL is in flight or charging
      */
     bool is_blocked();
 
@@ -86,6 +174,22 @@ class eVTOL_Sim {
      */
     void tick();
 
+    /**
+     * @brief Process several ticks at once, in closed form
+     * 
+     * Equivalent to num_ticks tick() calls, with the clock advanced before
+     * each, assuming a charger is granted at every flight end. The caller
+     * must guarantee that (no contention), advance the clock afterwards and
+     * reconcile the charger occupancy. Faults are drawn in one batch per
+     * flight. A flight end may ground the VTOL (with a bay pool set), in
+     * which case it stops there until released by the pool; its grounded
+     * time is then accrued by sync_grounded_time. Must not be called while
+     * WAITING_TO_CHARGE or grounded.
+     * 
+     * @param num_ticks - Number of ticks to process
+     */
+    void fast_forward(int64_t num_ticks);
+
     /**
      * @brief Get the eVTOL company for this instance
      * 
@@ -93,12 +197,64 @@ class eVTOL_Sim {
      */
     VTOL_Comp_e get_company();
 
+    /**
+     * @brief Get the current FSM state for this instance
+     * 
+     * @return VTOL_State_e - Current state
+     */
+    VTOL_State_e get_state();
+
+    /**
+     * @brief Get the timestamp the current flight or charge ends at
+     * 
+     * @return T - Flight end if IN_FLIGHT, otherwise charge end (in hours)
+     */
+    T get_phase_end_timestamp();
+
+    /**
+     * @brief Get the duration of a full flight (battery capacity / cruise power)
+     * 
+     * @return T - Flight time (in hours)
+     */
+    T get_flight_time_hr();
+
+    /**
+     * @brief Get the duration of a full charge
+     * 
+     * @return T - Charge time (in hours)
+     */
+    T get_chg_time_hr();
+
+    /**
+     * @brief Seed the fault random generator
+     * 
+     * @param seed - Seed value
+     */
+    void seed_faults(unsigned int seed);
+
+    /**
+     * @brief Configure a tilted fault rate for importance sampling
+     * 
+     * Each draw's log likelihood ratio (true vs. tilted rate) is accumulated
+     * in stats.fault_log_weight. If sample_tilted is set, faults are also
+     * drawn at the tilted rate, and weighting any fault-derived quantity by
+     * exp(fault_log_weight) gives an unbiased estimate under the true rate.
+     * Otherwise faults are drawn at the true rate and the ratio is only
+     * tracked, for use in mixture estimators over several vehicles.
+     * 
+     * @param tilted_prob_per_hr - Tilted fault probability per hour (<= 0 to disable)
+     * @param sample_tilted - Draw faults at the tilted rate (default true)
+     */
+    void set_fault_importance_rate(float tilted_prob_per_hr, bool sample_tilted = true);
+
     /**
      * @brief Get pointer to this eVTOL's running statistics block
      * 
-     * @return VTOLStats_t* - Pointer to eVTOL sim statistics
+     * @return VTOLStats_T<T>* - Pointer to eVTOL sim statistics
      */
-    VTOLStats_t* get_stats_ptr();
+    VTOLStats_T<T>* get_stats_ptr();
 };
 
+typedef eVTOL_Sim_T<float> eVTOL_Sim;
+
 #endif // _VTOL_SIM_
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include <types.h>
+#include <evtol_sim.h>
+#include <flight_sim.h>
+#include "fault_tail.h"
+
+using namespace std;
+
+/**
+ * @brief Build an estimate from running sums
+ */
+static FaultTailEstimate_t make_estimate(double sum, double sum_sq, long count)
+{
+  FaultTailEstimate_t est = {0, 0, count};
+  if (count == 0) return est;
+
+  est.prob = sum / count;
+  if (count > 1) {
+    double var = (sum_sq - sum * sum / count) / (count - 1);
+    est.std_err = sqrt(fmax(var, 0) / count);
+  }
+  return est;
+}
+
+FaultTailEstimator::FaultTailEstimator(int num_vtols, int num_chargers, float tick_rate, float sim_time_hr, VTOL_Comp_e comp)
+{
+  this->num_vtols    = num_vtols;
+  this->num_chargers = num_chargers;
+  this->tick_rate    = tick_rate;
+  this->sim_time_hr  = sim_time_hr;
+  this->comp         = comp;
+
+  for (int company = 0; company < MAX_COMPANIES; company++) {
+    vehicle_sum[company]    = 0;
+    vehicle_sum_sq[company] = 0;
+    vehicle_count[company]  = 0;
+  }
+  fleet_sum    = 0;
+  fleet_sum_sq = 0;
+  fleet_count  = 0;
+  min_faults   = 0;
+}
+
+void FaultTailEstimator::run(int num_runs, int min_faults, float tilted_prob_per_hr, unsigned int seed)
+{
+  this->min_faults = min_faults;
+
+  for (int run = 0; run < num_runs; run++)
+  {
+    unsigned int run_seed = seed + run * (num_vtols + 1);
+
+    FlightSim sim_inst(num_vtols, num_chargers, tick_rate, comp);
+    sim_inst.set_verbose(false);
+    sim_inst.seed_faults(run_seed + 1);
+
+    // Pick the tilted vehicle for this run (mixture component)
+    minstd_rand pick_gen(run_seed);
+    uniform_int_distribution<int> pick_dist(0, sim_inst.get_num_vtols() - 1);
+    sim_inst.set_fault_importance_rate(tilted_prob_per_hr, pick_dist(pick_gen));
+
+    sim_inst.sim_flight(sim_time_hr);
+
+    // Gather per-vehicle outcomes and likelihood ratios
+    vector<int> hit_comps;
+    vector<double> log_weights;
+    for (int company = 0; company < MAX_COMPANIES; company++)
+    {
+      for (shared_ptr<eVTOL_Sim> vtol_p : sim_inst.get_company_vtols(static_cast<VTOL_Comp_e>(company)))
+      {
+        VTOLStats_t* stats_p = vtol_p->get_stats_ptr();
+        if (stats_p->num_faults >= min_faults) hit_comps.push_back(company);
+        log_weights.push_back(stats_p->fault_log_weight);
+        ++vehicle_count[company];
+      }
+    }
+
+    // Mixture weight n / sum_j exp(-log L_j), offset by the smallest log
+    // ratio to avoid overflow
+    double min_log = INFINITY;
+    for (double log_w : log_weights) min_log = fmin(min_log, log_w);
+    double inv_sum = 0;
+    for (double log_w : log_weights) inv_sum += exp(min_log - log_w);
+    double run_weight = log_weights.size() * exp(min_log) / inv_sum;
+
+    for (int company : hit_comps) {
+      vehicle_sum[company]    += run_weight;
+      vehicle_sum_sq[company] += run_weight * run_weight;
+    }
+
+    double run_term = hit_comps.empty() ? 0 : run_weight;
+    fleet_sum    += run_term;
+    fleet_sum_sq += run_term * run_term;
+    ++fleet_count;
+  }
+}
+
+FaultTailEstimate_t FaultTailEstimator::get_vehicle_estimate(VTOL_Comp_e company)
+{
+  return make_estimate(vehicle_sum[company], vehicle_sum_sq[company], vehicle_count[company]);
+}
+
+FaultTailEstimate_t FaultTailEstimator::get_fleet_estimate()
+{
+  return make_estimate(fleet_sum, fleet_sum_sq, fleet_count);
+}
+
+void FaultTailEstimator::display_estimates()
+{
+  cout << "Fault Tail Estimates (>= " << min_faults << " faults in a "
+       << sim_time_hr << " hour shift):\n" << endl;
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(company);
+    if (vehicle_count[company] == 0) continue;
+
+    FaultTailEstimate_t est = get_vehicle_estimate(comp_enum);
+    cout << "\t" << COMP_NAMES.at(comp_enum) << " per vehicle: " << est.prob
+         << " +/- " << est.std_err << " (" << est.num_samples << " vehicles)" << endl;
+  }
+
+  FaultTailEstimate_t est = get_fleet_estimate();
+  cout << "\tAny vehicle in fleet: " << est.prob << " +/- " << est.std_err
+       << " (" << est.num_samples << " runs)" << endl;
+  cout << endl;
+}
@@ -0,0 +1,93 @@
+/**
+ * Rare-event fault statistics via importance sampling
+ * 
+ * Runs independent FlightSim replications with faults drawn at a tilted
+ * (higher) rate, and reweights each outcome by its likelihood ratio to get
+ * unbiased estimates of fault tail probabilities under the true rates.
+ * 
+ * Tilting every vehicle at once makes the fleet likelihood ratio degenerate
+ * as the fleet grows, so a mixture proposal is used instead: each run tilts
+ * one uniformly chosen vehicle, and outcomes are weighted by
+ * n / sum_j (1 / L_j), where L_j is vehicle j's likelihood ratio.
+ */
+
+#ifndef _FAULT_TAIL_
+#define _FAULT_TAIL_
+
+#include <types.h>
+
+// Tail probability estimate
+typedef struct FaultTailEstimate_t {
+  double prob;        // Unbiased probability estimate
+  double std_err;     // Standard error of the estimate
+  long num_samples;   // Number of samples (vehicles or runs) averaged
+} FaultTailEstimate_t;
+
+class FaultTailEstimator {
+  private:
+    // Simulation setup, used for every replication
+    int num_vtols;
+    int num_chargers;
+    float tick_rate;
+    float sim_time_hr;
+    VTOL_Comp_e comp;
+
+    // Running sums of weighted indicator and its square
+    double vehicle_sum[MAX_COMPANIES];
+    double vehicle_sum_sq[MAX_COMPANIES];
+    long vehicle_count[MAX_COMPANIES];
+    double fleet_sum;
+    double fleet_sum_sq;
+    long fleet_count;
+
+    int min_faults; // Threshold of the last run
+
+  public:
+    /**
+     * @brief Construct a new Fault Tail Estimator object
+     * 
+     * @param num_vtols - Number of eVTOLs per replication
+     * @param num_chargers - Number of chargers per replication
+     * @param tick_rate - Hours passed per tick
+     * @param sim_time_hr - Shift length (simulated hours per replication)
+     * @param comp - Company designation (default random)
+     */
+    FaultTailEstimator(int num_vtols, int num_chargers, float tick_rate, float sim_time_hr, VTOL_Comp_e comp = MAX_COMPANIES);
+
+    /**
+     * @brief Run replications and accumulate tail estimates
+     * 
+     * Estimates P(a vehicle has >= min_faults in a shift) per company, and
+     * P(any vehicle in the fleet has >= min_faults in a shift).
+     * A good tilted rate makes the event typical, e.g. roughly min_faults
+     * divided by the expected flight hours per shift.
+     * 
+     * @param num_runs - Number of independent replications
+     * @param min_faults - Fault count threshold
+     * @param tilted_prob_per_hr - Sampling fault probability per hour (<= 0 for crude Monte Carlo)
+     * @param seed - Base seed; replication r uses seed + r * (num_vtols + 1)
+     */
+    void run(int num_runs, int min_faults, float tilted_prob_per_hr, unsigned int seed = 0);
+
+    /**
+     * @brief Get the per-vehicle tail estimate for one company
+     * 
+     * @param company - Company designation
+     * @return FaultTailEstimate_t - P(vehicle has >= min_faults in a shift)
+     */
+    FaultTailEstimate_t get_vehicle_estimate(VTOL_Comp_e company);
+
+    /**
+     * @brief Get the fleet-level tail estimate
+     * 
+     * @return FaultTailEstimate_t - P(any vehicle has >= min_faults in a shift)
+     */
+    FaultTailEstimate_t get_fleet_estimate();
+
+    /**
+     * @brief Print all estimates
+     */
+    void display_estimates();
+};
+
+#endif // _FAULT_TAIL_
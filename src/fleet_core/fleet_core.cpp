@@ -0,0 +1,102 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include <types.h>
+#include <dual.h>
+#include <evtol_sim.h>
+#include <global_clk.h>
+#include <charger.h>
+#include "fleet_core.h"
+
+using namespace std;
+
+int calc_pct_complete(float time_complete_hr, float sim_time_hr)
+{
+  return (int)roundf(100.0 * (time_complete_hr / sim_time_hr));
+}
+
+template <typename T>
+FleetCore_T<T>::FleetCore_T(int num_chargers, float tick_rate, const map<VTOL_Comp_e, VTOLParams_t>& comp_params)
+{
+  this->comp_params = comp_params;
+
+  // Instantiate clock
+  global_clk = make_shared<GlobalClk_T<T>>(0, tick_rate);
+  // Instantiate charger
+  charger = make_shared<Charger_T<T>>(num_chargers);
+}
+
+template <typename T>
+VTOLParams_T<T> FleetCore_T<T>::_vtol_params(VTOL_Comp_e company)
+{
+  return convert_params<T>(comp_params.at(company));
+}
+
+template <typename T>
+void FleetCore_T<T>::_add_vtol(VTOL_Comp_e company)
+{
+  // Instantiate instance
+  shared_ptr<eVTOL_Sim_T<T>> evtol_p = make_shared<eVTOL_Sim_T<T>>(company, _vtol_params(company), global_clk, charger);
+  if (maintenance != nullptr) evtol_p->set_maintenance_bay(maintenance);
+
+  // Push into main queue
+  evtol_arr.push_back(evtol_p);
+
+  // Push into relevant queue for stats aggregation
+  evtol_companies[company].push_back(evtol_p);
+}
+
+template <typename T>
+void FleetCore_T<T>::_add_vtols(int num_vtols, VTOL_Comp_e comp)
+{
+  // Init randomizer
+  random_device rd;
+  uniform_int_distribution<int> dist(ALPHA, ECHO);
+
+  // Iterate over and instantiate eVTOL sims
+  for (int i = 0; i < num_vtols; i++) {
+    // Set to company parameter, unless input is "MAX_COMPANIES"
+    // If max, randomize per instance
+    VTOL_Comp_e company = (comp == MAX_COMPANIES) ? (VTOL_Comp_e)(dist(rd)) : comp;
+
+    _add_vtol(company);
+  }
+}
+
+template <typename T>
+void FleetCore_T<T>::_sim_tick()
+{
+  // Start by ticking clock
+  global_clk->tick();
+
+  // Next iterate through all VTOLs
+  for (shared_ptr<eVTOL_Sim_T<T>> vtol : evtol_arr) {
+      // If particular VTOL is blocked, skip
+      if (vtol->is_blocked()) {
+        continue;
+      }
+
+      // Activate tick
+      vtol->tick();
+  }
+
+  // TODO: add means to track per-tick stats here
+
+  // Landings this tick are queued, so bays can be handed out
+  if (maintenance != nullptr) maintenance->process(global_clk->get_timestamp());
+
+  // Iterate again, checking
+  // This is done separately to avoid ticking instances twice
+  // but still update based on charger availability
+  for (shared_ptr<eVTOL_Sim_T<T>> vtol : evtol_arr) {
+    vtol->check_blocked();
+  }
+
+  // Any session reported from here on starts after this tick
+  if (power_timeline != nullptr) power_timeline->commit(scalar_value(global_clk->get_timestamp()));
+}
+
+// Explicit instantiations for supported scalar types
+template class FleetCore_T<float>;
+template class FleetCore_T<Dual>;
@@ -0,0 +1,102 @@
+/**
+ * Fleet instantiation and tick processing shared by the simulators
+ *
+ * FlightSim (float) and SensitivitySim (Dual) run the same fleet: eVTOLs on
+ * one clock and charger pool, ticked in the same order and run for the same
+ * number of ticks. Both derive from this, so the two can't drift apart and
+ * the value part of a sensitivity run matches a float run.
+ */
+
+#ifndef _FLEET_CORE_
+#define _FLEET_CORE_
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <types.h>
+#include <evtol_sim.h>
+#include <global_clk.h>
+#include <charger.h>
+#include <maintenance_bay.h>
+#include <power_timeline.h>
+
+/**
+ * @brief Percent of a run complete, as used to end a run
+ *
+ * Runs end on the first tick this reaches 100, i.e. at or past 99.5% of the
+ * requested time
+ *
+ * @param time_complete_hr - Time simulated so far
+ * @param sim_time_hr - Requested simulation time
+ * @return int - Percent complete, rounded
+ */
+int calc_pct_complete(float time_complete_hr, float sim_time_hr);
+
+// Templated over scalar type; instantiated for float and Dual
+template <typename T>
+class FleetCore_T {
+  protected:
+    // Main array of VTOLs
+    std::vector<std::shared_ptr<eVTOL_Sim_T<T>>> evtol_arr;
+
+    // Array of vectors for stats aggregation
+    std::vector<std::shared_ptr<eVTOL_Sim_T<T>>> evtol_companies[MAX_COMPANIES];
+
+    // Charger instance
+    std::shared_ptr<Charger_T<T>> charger;
+
+    // Maintenance bay pool, only instantiated when enabled
+    std::shared_ptr<MaintenanceBay_T<T>> maintenance;
+
+    // Global clock instance
+    std::shared_ptr<GlobalClk_T<T>> global_clk;
+
+    // Charger power-draw timeline, only instantiated when enabled
+    std::shared_ptr<PowerTimeline> power_timeline;
+
+    // Parameters new eVTOLs are built with, per company
+    std::map<VTOL_Comp_e, VTOLParams_t> comp_params;
+
+    /**
+     * @brief Construct an empty fleet
+     *
+     * @param num_chargers - Number of chargers to simulate
+     * @param tick_rate - Hours passed per tick
+     * @param comp_params - Parameters per company
+     */
+    FleetCore_T(int num_chargers, float tick_rate, const std::map<VTOL_Comp_e, VTOLParams_t>& comp_params);
+
+    virtual ~FleetCore_T() {}
+
+    /**
+     * @brief Get the parameters a new eVTOL of a company is built with
+     *
+     * The fleet's company parameters, converted to T, by default
+     *
+     * @param company - Company designation
+     * @return VTOLParams_T<T> - Vehicle parameters
+     */
+    virtual VTOLParams_T<T> _vtol_params(VTOL_Comp_e company);
+
+    /**
+     * @brief Instantiate one eVTOL and add it to the fleet
+     *
+     * @param company - Company designation
+     */
+    void _add_vtol(VTOL_Comp_e company);
+
+    /**
+     * @brief Instantiate eVTOLs of one company, or each of a random company
+     *
+     * @param num_vtols - Number of eVTOLs
+     * @param comp - Company designation (MAX_COMPANIES for random)
+     */
+    void _add_vtols(int num_vtols, VTOL_Comp_e comp);
+
+    /**
+     * @brief Advance the clock by one tick and process all VTOLs
+     */
+    void _sim_tick();
+};
+
+#endif // _FLEET_CORE_
@@ -1,41 +1,69 @@
 #include <iostream>
+#include <cmath>
 #include <vector>
+#include <queue>
 #include <random>
 #include <types.h>
 #include <evtol_sim.h>
 #include <global_clk.h>
 #include <charger.h>
+#include <company_stats.h>
+#include <fleet_core.h>
 #include "flight_sim.h"
 
 using namespace std;
 
+// Predicted charger acquire/release for one eVTOL, used by the fast-forward sweep
+typedef struct ChargerEvent_t {
+  int64_t tick;             // Tick the event takes effect on
+  bool acquire;             // Acquire (flight end) or release (charge end)
+  int vtol;                 // Index into evtol_arr
+  int64_t transition_tick;  // Tick the eVTOL changes state on
+  float phase_end;          // Timestamp the ending phase was due to end at
+} ChargerEvent_t;
+
+// Orders the sweep by tick, releases before acquires
+struct ChargerEventLater {
+  bool operator()(const ChargerEvent_t& a, const ChargerEvent_t& b) const {
+    if (a.tick != b.tick) return a.tick > b.tick;
+    return a.acquire && !b.acquire;
+  }
+};
+
 FlightSim::FlightSim(int num_vtols, int num_chargers, float tick_rate, VTOL_Comp_e comp)
+  : FleetCore_T<float>(num_chargers, tick_rate, COMP_MAP)
 {
-  // Instantiate clock
-  global_clk = make_shared<GlobalClk>(0, tick_rate);
-  // Instantiate charger
-  charger = make_shared<Charger>(num_chargers);
+  _init();
+  _add_vtols(num_vtols, comp);
+}
 
-  // Init randomizer
-  random_device rd;
-  mt19937 mt(rd());
-  uniform_int_distribution<int> dist(ALPHA, ECHO);
+FlightSim::FlightSim(const vector<VTOL_Comp_e>& companies, int num_chargers, float tick_rate,
+                     const map<VTOL_Comp_e, VTOLParams_t>& comp_params)
+  : FleetCore_T<float>(num_chargers, tick_rate, comp_params)
+{
+  _init();
 
-  // Iterate over and instantiate eVTOL sims
-  for (int i = 0; i < num_vtols; i++) {
-    // Set to company parameter, unless input is "MAX_COMPANIES"
-    // If max, randomize per instance. Just use rand() as this is a very simple randomization
-    VTOL_Comp_e company = (comp == MAX_COMPANIES) ? (VTOL_Comp_e)(dist(rd)) : comp;
+  for (VTOL_Comp_e company : companies) {
+    _add_vtol(company);
+  }
+}
 
-    // Instantiate instance
-    shared_ptr<eVTOL_Sim> evtol_p = make_shared<eVTOL_Sim>(company, global_clk, charger);
+void FlightSim::_init()
+{
+  verbose         = true;
+  fault_is_tilted = false;
+  stats_threads   = 0;
+  run_time_hr     = 0;
+  fault_seed      = -1;
 
-    // Push into main queue
-    evtol_arr.push_back(evtol_p);
+  metrics_interval_ticks = 0;
+  ticks_since_publish    = 0;
+  run_tick_count         = 0;
 
-    // Push into relevant queue for stats aggregation
-    evtol_companies[company].push_back(evtol_p);
-  }
+  fast_forward     = false;
+  ff_backoff_ticks = 1;
+  ff_wait_ticks    = 0;
+  ff_ticks_skipped = 0;
 }
 
 void FlightSim::display_company_makeup()
@@ -50,46 +78,319 @@ void FlightSim::display_company_makeup()
 
 void FlightSim::sim_flight(float sim_time_hr)
 {
-  cout << "Beginning Flight Sim, simulated duration: " << sim_time_hr << " hours" << endl;
+  if (verbose) cout << "Beginning Flight Sim, simulated duration: " << sim_time_hr << " hours" << endl;
   float start_timestamp = global_clk->get_timestamp();
   end_timestamp = start_timestamp + sim_time_hr;
 
   int pct_complete = 0;
+  _start_live_metrics();
+
+  ff_backoff_ticks = 1;
+  ff_wait_ticks    = 0;
+  ff_ticks_skipped = 0;
 
   while(pct_complete < 100)
   {
-    // Start by ticking clock
-    global_clk->tick();
-
-    // Next iterate through all VTOLs
-    for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) {
-        // If particular VTOL is blocked, skip
-        if (vtol->is_blocked()) {
-          continue;
-        }
-
-        // Activate tick
-        vtol->tick();
-    }
-
-    // TODO: add means to track per-tick stats here
-
-    // Iterate again, checking 
-    // This is done separately to avoid ticking instances twice
-    // but still update based on charger availability
-    for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) {
-      vtol->check_blocked();
+    // Skip ahead while no charger contention is possible, else tick as usual
+    int64_t num_ticks = fast_forward ? _try_fast_forward(start_timestamp, sim_time_hr) : 0;
+    if (num_ticks == 0) {
+      _sim_tick();
+      num_ticks = 1;
+    } else {
+      ff_ticks_skipped += num_ticks;
     }
 
     // Calc percentage complete via timestamp
     float time_complete_hr = global_clk->get_timestamp() - start_timestamp;
-    pct_complete = (int)roundf(100.0 * (time_complete_hr / sim_time_hr));
+    pct_complete = calc_pct_complete(time_complete_hr, sim_time_hr);
     // NOTE: print is unnecessary, as simulation is very quick
     // cout << pct_complete << "% complete @ " << global_clk->get_timestamp()
     //      << ", end time " << end_timestamp << endl;
+    // For long runs, use enable_live_metrics() and tools/metrics_reader instead
+    _tick_live_metrics(pct_complete, num_ticks);
   }
 
-  cout << "\nCompleted " << sim_time_hr << " hour simulation!" << endl;
+  if (metrics_pub != nullptr) _publish_live_metrics(pct_complete, false);
+  run_time_hr = sim_time_hr;
+
+  if (verbose) cout << "\nCompleted " << sim_time_hr << " hour simulation!" << endl;
+  if (verbose && fast_forward) cout << "Fast-forwarded " << ff_ticks_skipped << " ticks" << endl;
+}
+
+int64_t FlightSim::_predict_uncontended_ticks(int64_t max_ticks)
+{
+  // Nothing to predict if every eVTOL can hold a charger at once
+  if (charger->get_num_chargers() >= (int)evtol_arr.size()) return max_ticks;
+
+  priority_queue<ChargerEvent_t, vector<ChargerEvent_t>, ChargerEventLater> events;
+
+  // Seed with each eVTOL's current phase end. Releases take effect the tick
+  // after the charge end is processed, so a same-tick handover counts as held
+  for (int i = 0; i < (int)evtol_arr.size(); i++) {
+    ChargerEvent_t event;
+    event.acquire         = (evtol_arr[i]->get_state() == IN_FLIGHT);
+    event.vtol            = i;
+    event.phase_end       = evtol_arr[i]->get_phase_end_timestamp();
+    event.transition_tick = global_clk->ticks_until(event.phase_end);
+    event.tick            = event.transition_tick + (event.acquire ? 0 : 1);
+    events.push(event);
+  }
+
+  int in_use       = charger->get_chargers_in_use();
+  int num_chargers = charger->get_num_chargers();
+  while (!events.empty() && events.top().tick <= max_ticks)
+  {
+    ChargerEvent_t event = events.top();
+    events.pop();
+
+    // Next phase, with the same timestamp arithmetic as the eVTOL itself
+    shared_ptr<eVTOL_Sim> vtol = evtol_arr[event.vtol];
+    if (event.acquire) {
+      if (++in_use > num_chargers) return event.tick - 1;
+      event.phase_end += vtol->get_chg_time_hr();
+    } else {
+      --in_use;
+      event.phase_end += vtol->get_flight_time_hr();
+    }
+
+    // One transition per tick at most
+    int64_t transition_tick = global_clk->ticks_until(event.phase_end);
+    event.transition_tick = max(transition_tick, event.transition_tick + 1);
+    event.acquire         = !event.acquire;
+    event.tick            = event.transition_tick + (event.acquire ? 0 : 1);
+    events.push(event);
+  }
+
+  return max_ticks;
+}
+
+int64_t FlightSim::_try_fast_forward(float start_timestamp, float sim_time_hr)
+{
+  if (ff_wait_ticks > 0) {
+    --ff_wait_ticks;
+    return 0;
+  }
+
+  // Contention already under way
+  if (charger->get_wait_q_len() > 0) return 0;
+
+  // Serviced eVTOLs rejoin the chargers at times the prediction can't see,
+  // so with maintenance only skip ahead if every eVTOL can hold a charger
+  if (maintenance != nullptr && charger->get_num_chargers() < (int)evtol_arr.size()) return 0;
+
+  // Last tick of the run, per sim_flight's completion check
+  int64_t max_ticks = global_clk->ticks_until(start_timestamp + 0.995f * sim_time_hr);
+  while (max_ticks > 1 && calc_pct_complete(global_clk->get_tick_timestamp(max_ticks - 1) - start_timestamp, sim_time_hr) >= 100) {
+    --max_ticks;
+  }
+  while (calc_pct_complete(global_clk->get_tick_timestamp(max_ticks) - start_timestamp, sim_time_hr) < 100) {
+    ++max_ticks;
+  }
+
+  int64_t num_ticks = _predict_uncontended_ticks(max_ticks);
+  if (num_ticks < FF_MIN_TICKS) {
+    ff_wait_ticks    = ff_backoff_ticks;
+    ff_backoff_ticks = min(2 * ff_backoff_ticks, FF_MAX_BACKOFF_TICKS);
+    return 0;
+  }
+  ff_backoff_ticks = 1;
+
+  // Advance each eVTOL before the clock, as it works relative to the current
+  // tick. Grounded eVTOLs wait for the bay pool
+  for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) {
+    VTOL_State_e state = vtol->get_state();
+    if (state == IN_FLIGHT || state == CHARGING) vtol->fast_forward(num_ticks);
+  }
+  if (maintenance != nullptr) {
+    _fast_forward_maintenance(num_ticks);
+  } else {
+    global_clk->advance(num_ticks);
+  }
+
+  int in_use = 0;
+  for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) {
+    vtol->check_blocked();
+    if (vtol->get_state() == CHARGING) ++in_use;
+  }
+  charger->set_chargers_in_use(in_use);
+  if (power_timeline != nullptr) power_timeline->commit(global_clk->get_timestamp());
+
+  return num_ticks;
+}
+
+void FlightSim::_fast_forward_maintenance(int64_t num_ticks)
+{
+  int64_t ticks_done = 0;
+  vector<eVTOL_Sim*> released;
+  while (true)
+  {
+    double next_timestamp = maintenance->get_next_event_timestamp();
+    if (std::isinf(next_timestamp)) break;
+    int64_t ticks = global_clk->ticks_until(next_timestamp);
+    if (ticks_done + ticks > num_ticks) break;
+
+    global_clk->advance(ticks);
+    ticks_done += ticks;
+
+    // With a charger per eVTOL none is ever refused, so the occupancy only
+    // matters once reconciled at the end of the stretch
+    charger->set_chargers_in_use(0);
+    released.clear();
+    maintenance->process(global_clk->get_timestamp(), &released);
+    for (eVTOL_Sim* vtol : released) vtol->fast_forward(num_ticks - ticks_done);
+  }
+  global_clk->advance(num_ticks - ticks_done);
+
+  // Catch up on the grounded time detailed ticks would have accrued
+  for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) vtol->sync_grounded_time();
+}
+
+void FlightSim::_record_steady_state_obs()
+{
+  int state_counts[MAX_COMPANIES][MAX_STATES] = {};
+  for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) {
+    ++state_counts[vtol->get_company()][vtol->get_state()];
+  }
+
+  float obs[SS_NUM_SERIES] = {};
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    // Empty companies stay at zero, which the detector treats as settled
+    if (evtol_companies[company].empty()) continue;
+    float num_vtols = evtol_companies[company].size();
+    obs[SS_WAIT_SERIES(company)]   = state_counts[company][WAITING_TO_CHARGE] / num_vtols;
+    obs[SS_FLIGHT_SERIES(company)] = state_counts[company][IN_FLIGHT] / num_vtols;
+  }
+  obs[SS_CHARGER_SERIES] = (float)charger->get_chargers_in_use() / charger->get_num_chargers();
+
+  ss_detector->add_observation(obs);
+}
+
+void FlightSim::_record_steady_state_snapshot()
+{
+  // One snapshot per batch boundary, including the start of the run
+  if ((int)ss_snapshots[0].size() > ss_detector->get_num_batches()) return;
+  for (int company = 0; company < MAX_COMPANIES; company++) {
+    ss_snapshots[company].push_back(compute_company_stats<float>(static_cast<VTOL_Comp_e>(company), evtol_companies[company]));
+  }
+}
+
+bool FlightSim::sim_until_converged(float max_sim_time_hr, float rel_precision, float check_interval_hr, float abs_precision)
+{
+  if (verbose) {
+    cout << "Beginning Flight Sim until steady state, max duration: " << max_sim_time_hr
+         << " hours, target precision: " << rel_precision * 100 << "%" << endl;
+  }
+  float start_timestamp = global_clk->get_timestamp();
+  end_timestamp = start_timestamp + max_sim_time_hr;
+
+  // Fresh detector per run, so earlier runs don't count as warm-up
+  ss_detector = make_shared<SteadyStateDetector>(SS_NUM_SERIES);
+  for (int company = 0; company < MAX_COMPANIES; company++) ss_snapshots[company].clear();
+  _record_steady_state_snapshot();
+
+  float next_check = start_timestamp + check_interval_hr;
+  bool converged   = false;
+  _start_live_metrics();
+
+  while (!converged && global_clk->get_timestamp() < end_timestamp)
+  {
+    _sim_tick();
+    _record_steady_state_obs();
+    _record_steady_state_snapshot();
+    _tick_live_metrics(100.0 * (global_clk->get_timestamp() - start_timestamp) / max_sim_time_hr);
+
+    if (global_clk->get_timestamp() < next_check) continue;
+    next_check += check_interval_hr;
+    converged = ss_detector->evaluate(rel_precision, abs_precision);
+  }
+
+  // Make sure reported figures reflect all collected data
+  if (!converged) converged = ss_detector->evaluate(rel_precision, abs_precision);
+  if (metrics_pub != nullptr) _publish_live_metrics(100, false);
+
+  float sim_time_hr = global_clk->get_timestamp() - start_timestamp;
+  run_time_hr = sim_time_hr;
+  if (verbose) {
+    cout << "\n" << (converged ? "Converged" : "Did not converge") << " after "
+         << sim_time_hr << " hour simulation!" << endl;
+  }
+  return converged;
+}
+
+CompanyStats_t FlightSim::get_steady_state_company_stats(VTOL_Comp_e company)
+{
+  CompanyStats_t out = CompanyStats_t();
+  out.num_vtols = evtol_companies[company].size();
+  if (ss_detector == nullptr || ss_detector->get_window_batches() == 0) return out;
+
+  // Difference of the snapshots bounding the window; each average is over
+  // the same vehicles, so this is the per-vehicle average over the window
+  const CompanyStats_t& first = ss_snapshots[company][ss_detector->get_truncated_batches()];
+  const CompanyStats_t& last  = ss_snapshots[company][ss_detector->get_truncated_batches() + ss_detector->get_window_batches()];
+  out.avg_flight_time_hr     = last.avg_flight_time_hr     - first.avg_flight_time_hr;
+  out.avg_flight_distance_mi = last.avg_flight_distance_mi - first.avg_flight_distance_mi;
+  out.avg_charging_time_hr   = last.avg_charging_time_hr   - first.avg_charging_time_hr;
+  out.avg_waiting_time_hr    = last.avg_waiting_time_hr    - first.avg_waiting_time_hr;
+  out.total_faults           = last.total_faults           - first.total_faults;
+  out.weighted_faults        = last.weighted_faults        - first.weighted_faults;
+  out.total_passenger_miles  = last.total_passenger_miles  - first.total_passenger_miles;
+  return out;
+}
+
+float FlightSim::get_steady_state_window_hr()
+{
+  if (ss_detector == nullptr) return 0;
+  return ss_detector->get_window_batches() * MSER_BATCH_SIZE * global_clk->get_hr_per_tick();
+}
+
+shared_ptr<SteadyStateDetector> FlightSim::get_steady_state_detector()
+{
+  return ss_detector;
+}
+
+void FlightSim::display_steady_state_stats()
+{
+  if (ss_detector == nullptr || ss_detector->get_num_obs() == 0)
+  {
+    cout << "No steady-state data collected.\n" << endl;
+    return;
+  }
+
+  float hr_per_tick = global_clk->get_hr_per_tick();
+  cout << "Steady-State Statistics (95% CI):" << endl;
+  cout << "\tWarm-up truncated:     " << ss_detector->get_truncated_obs() * hr_per_tick << " hours" << endl;
+  cout << "\tSteady-state window:   " << get_steady_state_window_hr() << " hours" << endl;
+  cout << "\tCharger Utilization:   " << ss_detector->get_mean(SS_CHARGER_SERIES)
+       << " +/- " << ss_detector->get_half_width(SS_CHARGER_SERIES) << endl;
+  cout << endl;
+
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    if (evtol_companies[company].empty()) continue;
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(company);
+    cout << COMP_NAMES.at(comp_enum) << " Steady-State:" << endl;
+    cout << "\tFlight Fraction:       " << ss_detector->get_mean(SS_FLIGHT_SERIES(company))
+         << " +/- " << ss_detector->get_half_width(SS_FLIGHT_SERIES(company)) << endl;
+    cout << "\tWaiting Fraction:      " << ss_detector->get_mean(SS_WAIT_SERIES(company))
+         << " +/- " << ss_detector->get_half_width(SS_WAIT_SERIES(company)) << endl;
+    cout << endl;
+  }
+
+  // Same statistics as aggregate_company_stats, over the window only
+  cout << "Steady-State Window Statistics (per vehicle over " << get_steady_state_window_hr() << " hours):\n" << endl;
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    if (evtol_companies[company].empty()) continue;
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(company);
+    display_company_stats(comp_enum, get_steady_state_company_stats(comp_enum), fault_is_tilted);
+  }
+}
+
+CompanyStats_t FlightSim::get_company_stats(VTOL_Comp_e company)
+{
+  if (stats_threads > 0) return reduce_company_stats(company, evtol_companies[company], stats_threads);
+  return compute_company_stats<float>(company, evtol_companies[company]);
 }
 
 void FlightSim::aggregate_company_stats() {
@@ -105,44 +406,212 @@ void FlightSim::aggregate_company_stats() {
     }
 
     // Otherwise, proceed with stats aggregation
-    // Instantiate running statistics for company
-    float avg_flight_time       = 0;
-    float avg_flight_distance   = 0;
-    float avg_charging_time     = 0;
-    float avg_waiting_time      = 0;
-    int total_faults            = 0;
-    float total_passenger_miles = 0;
-
-    // For averages
-    float num_vtols = evtol_companies[company].size();
+    display_company_stats(comp_enum, get_company_stats(comp_enum), fault_is_tilted);
+  }
+}
 
-    // Iterate over all eVTOLs of company make
-    for (shared_ptr<eVTOL_Sim> vtol_p : evtol_companies[company])
-    {
-      VTOLStats_t* stats_p = vtol_p->get_stats_ptr();
-      // Averages
-      avg_flight_time += stats_p->vehicle_fly_time_hr / num_vtols;
-      avg_flight_distance += stats_p->vehicle_fly_distance_mi / num_vtols;
-      avg_charging_time += stats_p->total_charge_time_hr / num_vtols;
-      avg_waiting_time += stats_p->charge_wait_time_hr / num_vtols;
-      // Totals
-      total_faults += stats_p->num_faults;
-      total_passenger_miles += stats_p->vehicle_fly_distance_mi * VTOL_PASSENGERS.at(comp_enum);
+void FlightSim::force_time(float timestamp)
+{
+  global_clk->set_timestamp(timestamp);
+}
+
+void FlightSim::set_verbose(bool verbose)
+{
+  this->verbose = verbose;
+}
+
+void FlightSim::set_stats_threads(int num_threads)
+{
+  stats_threads = num_threads;
+}
+
+void FlightSim::enable_fast_forward(bool enable)
+{
+  fast_forward = enable;
+}
+
+void FlightSim::seed_faults(unsigned int seed)
+{
+  fault_seed = seed;
+  for (size_t i = 0; i < evtol_arr.size(); i++) {
+    evtol_arr[i]->seed_faults(seed + i);
+  }
+  if (maintenance != nullptr) maintenance->seed(seed);
+}
+
+void FlightSim::set_fault_importance_rate(float tilted_prob_per_hr, int tilted_index)
+{
+  for (int i = 0; i < (int)evtol_arr.size(); i++) {
+    evtol_arr[i]->set_fault_importance_rate(tilted_prob_per_hr, tilted_index < 0 || tilted_index == i);
+  }
+  // Weighted totals are only unbiased if every eVTOL sampled tilted
+  fault_is_tilted = (tilted_prob_per_hr > 0) && (tilted_index < 0);
+}
+
+shared_ptr<MaintenanceBay> FlightSim::enable_maintenance(int num_bays)
+{
+  maintenance = make_shared<MaintenanceBay>(num_bays);
+  if (fault_seed >= 0) maintenance->seed(fault_seed);
+  for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) {
+    vtol->set_maintenance_bay(maintenance);
+  }
+  return maintenance;
+}
+
+float FlightSim::get_availability(VTOL_Comp_e company)
+{
+  float vehicle_hr = evtol_companies[company].size() * global_clk->get_timestamp();
+  if (vehicle_hr <= 0) return 1;
+
+  float grounded_hr = 0;
+  for (shared_ptr<eVTOL_Sim> vtol : evtol_companies[company]) {
+    VTOLStats_t* stats_p = vtol->get_stats_ptr();
+    grounded_hr += stats_p->maintenance_wait_time_hr + stats_p->maintenance_time_hr;
+  }
+  return 1 - grounded_hr / vehicle_hr;
+}
+
+void FlightSim::display_maintenance_stats()
+{
+  if (maintenance == nullptr)
+  {
+    cout << "Maintenance not enabled.\n" << endl;
+    return;
+  }
+
+  cout << "Maintenance (" << maintenance->get_num_bays() << " bays, " << maintenance->get_bays_in_use()
+       << " in use, " << maintenance->get_wait_q_len() << " waiting):\n" << endl;
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(company);
+    if (evtol_companies[company].empty()) continue;
+
+    int groundings   = 0;
+    float wait_hr    = 0;
+    float service_hr = 0;
+    for (shared_ptr<eVTOL_Sim> vtol : evtol_companies[company]) {
+      VTOLStats_t* stats_p = vtol->get_stats_ptr();
+      groundings += stats_p->num_groundings;
+      wait_hr    += stats_p->maintenance_wait_time_hr;
+      service_hr += stats_p->maintenance_time_hr;
     }
+    float num_vtols = evtol_companies[company].size();
 
-    cout << COMP_NAMES.at(comp_enum) << " Statistics:" << endl;
-    cout << "\tAvg. Flight Time:      " << avg_flight_time << " hours" << endl;
-    cout << "\tAvg. Flight Distance:  " << avg_flight_distance << " miles" << endl;
-    cout << "\tAvg. Charging Time:    " << avg_charging_time << " hours" << endl;
-    cout << "\tTotal Faults:          " << total_faults << endl;
-    cout << "\tTotal Passenger Miles: " << total_passenger_miles << endl;
-    cout << "\tAvg. Waiting Time:     " << avg_waiting_time << " hours" << endl;
-    cout << endl; // Extra line break between company stats blocks
+    cout << COMP_NAMES.at(comp_enum) << " Maintenance:" << endl;
+    cout << "\tGroundings:            " << groundings << endl;
+    cout << "\tAvg. Bay Wait Time:    " << wait_hr / num_vtols << " hours" << endl;
+    cout << "\tAvg. Service Time:     " << service_hr / num_vtols << " hours" << endl;
+    cout << "\tAvailability:          " << get_availability(comp_enum) * 100 << "%" << endl;
+    cout << endl;
   }
 }
 
-void FlightSim::force_time(float timestamp)
+void FlightSim::enable_power_timeline()
 {
-  global_clk->set_timestamp(timestamp);
+  power_timeline        = make_shared<PowerTimeline>();
+  power_start_timestamp = global_clk->get_timestamp();
+  charger->set_power_timeline(power_timeline);
+}
+
+shared_ptr<PowerTimeline> FlightSim::get_power_timeline()
+{
+  return power_timeline;
+}
+
+void FlightSim::display_power_stats()
+{
+  if (power_timeline == nullptr)
+  {
+    cout << "Power timeline not enabled.\n" << endl;
+    return;
+  }
+
+  double start = power_start_timestamp;
+  double end   = power_timeline->get_committed_timestamp();
+  double peak_demand = power_timeline->get_peak_demand_kw(start, end, DEMAND_WINDOW_HR);
+
+  cout << "Charger Power Draw:" << endl;
+  cout << "\tSessions:              " << power_timeline->get_num_sessions() << endl;
+  cout << "\tTotal Energy:          " << power_timeline->get_energy_kwh(start, end) << " kWh" << endl;
+  cout << "\tAvg. Power:            " << power_timeline->get_avg_kw(start, end) << " kW" << endl;
+  cout << "\tPeak Power:            " << power_timeline->get_peak_kw(start, end) << " kW" << endl;
+  cout << "\tPeak " << DEMAND_WINDOW_HR * 60 << "-min Demand:    " << peak_demand << " kW" << endl;
+  cout << endl;
+}
+
+RunRecord_t FlightSim::get_run_record()
+{
+  RunRecord_t record = {};
+  record.num_vtols    = evtol_arr.size();
+  record.num_chargers = charger->get_num_chargers();
+  record.tick_rate    = global_clk->get_hr_per_tick();
+  record.sim_time_hr  = run_time_hr;
+  record.seed         = fault_seed;
+  for (int company = 0; company < MAX_COMPANIES; company++) {
+    record.company_stats[company] = get_company_stats(static_cast<VTOL_Comp_e>(company));
+  }
+  return record;
 }
 
+int FlightSim::get_num_vtols()
+{
+  return evtol_arr.size();
+}
+
+float FlightSim::get_timestamp()
+{
+  return global_clk->get_timestamp();
+}
+
+const vector<shared_ptr<eVTOL_Sim>>& FlightSim::get_company_vtols(VTOL_Comp_e company)
+{
+  return evtol_companies[company];
+}
+
+bool FlightSim::enable_live_metrics(int publish_interval_ticks, const char* name)
+{
+  metrics_pub = make_shared<LiveMetricsPublisher>(name);
+  if (!metrics_pub->is_open()) {
+    metrics_pub = nullptr;
+    return false;
+  }
+
+  metrics_interval_ticks = publish_interval_ticks;
+  return true;
+}
+
+void FlightSim::_start_live_metrics()
+{
+  if (metrics_pub == nullptr) return;
+  run_tick_count      = 0;
+  ticks_since_publish = 0;
+  last_publish_time   = chrono::steady_clock::now();
+  _publish_live_metrics(0, true);
+}
+
+void FlightSim::_publish_live_metrics(float pct_complete, bool running)
+{
+  LiveMetricsData_t data = {};
+
+  data.sim_time_hr  = global_clk->get_timestamp();
+  data.end_time_hr  = end_timestamp;
+  data.pct_complete = pct_complete;
+  data.tick_count   = run_tick_count;
+
+  // steady_clock is read through the vDSO, so this doesn't enter the kernel
+  chrono::steady_clock::time_point now = chrono::steady_clock::now();
+  double elapsed_s = chrono::duration<double>(now - last_publish_time).count();
+  data.ticks_per_sec = (elapsed_s > 0) ? ticks_since_publish / elapsed_s : 0;
+  last_publish_time   = now;
+  ticks_since_publish = 0;
+
+  for (shared_ptr<eVTOL_Sim> vtol : evtol_arr) {
+    ++data.state_counts[vtol->get_company()][vtol->get_state()];
+  }
+  data.chargers_in_use = charger->get_chargers_in_use();
+  data.num_chargers    = charger->get_num_chargers();
+  data.wait_q_len      = charger->get_wait_q_len();
+  data.running         = running;
+
+  metrics_pub->publish(data);
+}
@@ -6,6 +6,7 @@
 #define _FLIGHT_SIM_
 
 #include <iostream>
+#include <chrono>
 #include <deque>
 #include <deque>
 #include <memory>
@@ -13,25 +14,145 @@
 #include <evtol_sim.h>
 #include <global_clk.h>
 #include <charger.h>
+#include <maintenance_bay.h>
+#include <steady_state.h>
+#include <live_metrics.h>
+#include <results_archive.h>
+#include <power_timeline.h>
+#include <stats_reduce.h>
+#include <fleet_core.h>
 
 using namespace std;
 
-class FlightSim {
+// Steady-state series layout: two per company, plus charger utilization
+#define SS_WAIT_SERIES(comp)   (2 * (comp))
+#define SS_FLIGHT_SERIES(comp) (2 * (comp) + 1)
+#define SS_CHARGER_SERIES      (2 * MAX_COMPANIES)
+#define SS_NUM_SERIES          (2 * MAX_COMPANIES + 1)
+
+// Fast-forward: shortest uncontended stretch worth skipping, and the cap on
+// detailed ticks between attempts while contention persists
+#define FF_MIN_TICKS         (2)
+#define FF_MAX_BACKOFF_TICKS (64)
+
+// Demand-charge averaging window (utility standard of 15 minutes)
+#define DEMAND_WINDOW_HR (0.25)
+
+class FlightSim : public FleetCore_T<float> {
 
   private:
     float end_timestamp;
+    float run_time_hr;    // Requested duration of the last run (elapsed time if run until converged)
+    int64_t fault_seed;   // Base seed from seed_faults (-1 if unseeded)
+    bool verbose;         // Print progress messages from sim_flight
+    bool fault_is_tilted; // Faults drawn with importance sampling
+    int stats_threads;    // Threads for reproducible stats reduction (0 for serial float sums)
+
+    // Steady-state detector, only instantiated when running to convergence
+    shared_ptr<SteadyStateDetector> ss_detector;
+
+    // Per-company statistics at the start of each MSER batch (and the end of
+    // the last), so they can be reported over the steady-state window only
+    vector<CompanyStats_t> ss_snapshots[MAX_COMPANIES];
 
-    // Main array of VTOLs
-    vector<shared_ptr<eVTOL_Sim>> evtol_arr;
+    float power_start_timestamp; // Timestamp power timeline recording started at
 
-    // Array of vectors for stats aggregation 
-    vector<shared_ptr<eVTOL_Sim>> evtol_companies[MAX_COMPANIES];
+    // Live metrics publisher, only instantiated when enabled
+    shared_ptr<LiveMetricsPublisher> metrics_pub;
+    int metrics_interval_ticks; // Ticks between publishes
+    int ticks_since_publish;    // Ticks since last publish
+    int64_t run_tick_count;     // Ticks processed in current run
+    chrono::steady_clock::time_point last_publish_time;
 
-    // Charger instance
-    shared_ptr<Charger> charger;
+    // Fast-forward over uncontended stretches, only used by sim_flight
+    bool fast_forward;          // Enabled
+    int ff_backoff_ticks;       // Detailed ticks to run after a failed attempt
+    int ff_wait_ticks;          // Detailed ticks left before the next attempt
+    int64_t ff_ticks_skipped;   // Ticks fast-forwarded in current run
+
+    /**
+     * @brief Reset run state
+     */
+    void _init();
+
+    /**
+     * @brief Reset live metrics counters at the start of a run
+     */
+    void _start_live_metrics();
+
+    /**
+     * @brief Count a tick, publishing live metrics every metrics_interval_ticks
+     * 
+     * Kept inline and branch-light, as it's called from the sim loop
+     * 
+     * @param pct_complete - Percent of current run complete
+     * @param num_ticks - Ticks processed (more than one when fast-forwarding)
+     */
+    void _tick_live_metrics(float pct_complete, int64_t num_ticks = 1) {
+      if (metrics_pub == nullptr) return;
+      run_tick_count += num_ticks;
+      if ((ticks_since_publish += num_ticks) >= metrics_interval_ticks) _publish_live_metrics(pct_complete, true);
+    }
+
+    /**
+     * @brief Gather a snapshot of sim state and publish it
+     * 
+     * @param pct_complete - Percent of current run complete
+     * @param running - False once the run has finished
+     */
+    void _publish_live_metrics(float pct_complete, bool running);
+
+    /**
+     * @brief Record per-company waiting/flight fractions and charger
+     * utilization for the current tick into the steady-state detector
+     */
+    void _record_steady_state_obs();
+
+    /**
+     * @brief Snapshot per-company statistics if an MSER batch just completed
+     * 
+     * Also takes the initial snapshot when none exist yet
+     */
+    void _record_steady_state_snapshot();
+
+    /**
+     * @brief Predict how many ticks all eVTOLs can run without charger contention
+     * 
+     * Walks every eVTOL's future flight/charge cycle in tick indices, merging
+     * charger acquire/release ticks in order, until more chargers would be
+     * held than exist. A charger is counted as held on both its acquire and
+     * release ticks, so same-tick handovers are treated as contention.
+     * 
+     * @param max_ticks - Upper bound on the result
+     * @return int64_t - Ticks up to (not including) the first possible contention
+     */
+    int64_t _predict_uncontended_ticks(int64_t max_ticks);
+
+    /**
+     * @brief Fast-forward all eVTOLs over an uncontended stretch, if any
+     * 
+     * Only attempted when nothing is waiting for a charger (and, with
+     * maintenance enabled, when there is a charger per eVTOL), and never past
+     * the tick that completes the run. After a stretch too short to skip,
+     * attempts back off exponentially (in detailed ticks).
+     * 
+     * @param start_timestamp - Timestamp the run started at
+     * @param sim_time_hr - Run duration in hours
+     * @return int64_t - Ticks skipped (0 if the next tick should be detailed)
+     */
+    int64_t _try_fast_forward(float start_timestamp, float sim_time_hr);
 
-    // Global clock instance
-    shared_ptr<GlobalClk> global_clk;
+    /**
+     * @brief Advance the clock over a fast-forwarded stretch, replaying bay events
+     * 
+     * eVTOLs have been fast-forwarded up to the stretch end or their first
+     * grounding. Service starts and ends are processed in time order, each
+     * on the tick a detailed run would, and every released eVTOL is
+     * fast-forwarded from there (possibly to its next grounding).
+     * 
+     * @param num_ticks - Length of the stretch
+     */
+    void _fast_forward_maintenance(int64_t num_ticks);
   
   public:
     /**
@@ -44,6 +165,17 @@ class FlightSim {
      */
     FlightSim(int num_vtols, int num_chargers, float tick_rate, VTOL_Comp_e comp = MAX_COMPANIES);
 
+    /**
+     * @brief Construct a new Flight Sim object with an explicit fleet mix
+     * 
+     * @param companies - Company designation of each eVTOL, in order
+     * @param num_chargers - Number of chargers to simulate
+     * @param tick_rate - Hours passed per tick
+     * @param comp_params - Parameters per company (e.g. to perturb one)
+     */
+    FlightSim(const vector<VTOL_Comp_e>& companies, int num_chargers, float tick_rate,
+              const map<VTOL_Comp_e, VTOLParams_t>& comp_params = COMP_MAP);
+
     /**
      * @brief Print the company makeup for all eVTOLs
      * 
@@ -59,6 +191,63 @@ class FlightSim {
      */
     void sim_flight(float sim_time_hr);
 
+    /**
+     * @brief Simulate flight until per-company metrics reach steady state
+     * 
+     * Records the fraction of each company's fleet waiting and in flight, and
+     * charger utilization, every tick. At each check interval the warm-up
+     * transient is truncated (MSER-5) and batch-means confidence intervals
+     * are computed; the run stops once every CI half-width is within
+     * rel_precision of its mean (or within abs_precision, for series near
+     * zero), or max_sim_time_hr is reached.
+     * 
+     * @param max_sim_time_hr - Upper bound on simulation time in hours
+     * @param rel_precision - Target relative CI half-width (e.g. 0.05)
+     * @param check_interval_hr - Hours simulated between convergence checks
+     * @param abs_precision - Absolute CI half-width that always meets the target
+     * @return true - If the target precision was reached
+     * @return false - If max_sim_time_hr was reached first
+     */
+    bool sim_until_converged(float max_sim_time_hr, float rel_precision, float check_interval_hr = 1.0,
+                             float abs_precision = DEFAULT_ABS_PRECISION);
+
+    /**
+     * @brief Get one company's statistics over the steady-state window only
+     * 
+     * As per get_company_stats, but accumulated from the warm-up truncation
+     * point to the end of the window of the last sim_until_converged call,
+     * i.e. over get_steady_state_window_hr() hours
+     * 
+     * @param company - Company designation
+     * @return CompanyStats_t - Averages and totals over the window (zero if none)
+     */
+    CompanyStats_t get_steady_state_company_stats(VTOL_Comp_e company);
+
+    /**
+     * @brief Get the length of the steady-state window
+     * 
+     * @return float - Hours after warm-up used for the CIs of the last sim_until_converged call
+     */
+    float get_steady_state_window_hr();
+
+    /**
+     * @brief Get the steady-state detector of the last sim_until_converged call
+     * 
+     * Series are laid out as per SS_WAIT_SERIES, SS_FLIGHT_SERIES and SS_CHARGER_SERIES
+     * 
+     * @return shared_ptr<SteadyStateDetector> - Detector, null if never run
+     */
+    shared_ptr<SteadyStateDetector> get_steady_state_detector();
+
+    /**
+     * @brief Print steady-state estimates from the last sim_until_converged call
+     * 
+     * Waiting and flight figures are fractions of vehicle time, i.e. hours
+     * spent waiting or flying per vehicle-hour after the warm-up period.
+     * Followed by each company's statistics over the steady-state window.
+     */
+    void display_steady_state_stats();
+
     /**
      * @brief Aggregate statistics per eVTOL company
      * 
@@ -75,6 +264,25 @@ class FlightSim {
      */
     void aggregate_company_stats();
 
+    /**
+     * @brief Get aggregated statistics for one company
+     * 
+     * @param company - Company designation
+     * @return CompanyStats_t - Averages and totals, as printed by aggregate_company_stats
+     */
+    CompanyStats_t get_company_stats(VTOL_Comp_e company);
+
+    /**
+     * @brief Reduce company statistics in parallel, reproducibly
+     * 
+     * With num_threads > 0, get_company_stats (and everything built on it)
+     * uses reduce_company_stats, whose exact summation gives bit-identical
+     * results for any thread count. 0 restores the serial float sums.
+     * 
+     * @param num_threads - Worker threads per company reduction
+     */
+    void set_stats_threads(int num_threads);
+
     /**
      * @brief Force the global clock to the given timestamp
      * 
@@ -83,6 +291,156 @@ class FlightSim {
      * @param timestamp - Desired new timestamp
      */
     void force_time(float timestamp);
+
+    /**
+     * @brief Enable/disable progress messages printed by sim_flight
+     * 
+     * Useful when running many replications back to back
+     * 
+     * @param verbose - True to print (default)
+     */
+    void set_verbose(bool verbose);
+
+    /**
+     * @brief Enable/disable fast-forwarding in sim_flight
+     * 
+     * While no charger contention is possible, every eVTOL repeats a fixed
+     * flight/charge cycle, so sim_flight advances over such stretches in
+     * closed form (eVTOL_Sim_T::fast_forward), with one batch fault draw per
+     * flight, and only runs detailed ticks where contention is possible.
+     * Cost is then roughly per charger event rather than per tick. Every
+     * transition happens on the same tick as in a detailed run, so results
+     * differ only by float rounding of the summed times (about 1e-4
+     * relative over 500 h), with faults drawn from the same distribution.
+     * Has no effect on sim_until_converged, which observes every tick.
+     * 
+     * @param enable - True to fast-forward
+     */
+    void enable_fast_forward(bool enable = true);
+
+    /**
+     * @brief Seed the fault generators of all eVTOLs
+     * 
+     * Each eVTOL is seeded with seed + its index, so replications with
+     * different seeds draw independent faults
+     * 
+     * @param seed - Base seed
+     */
+    void seed_faults(unsigned int seed);
+
+    /**
+     * @brief Configure a tilted fault rate for importance sampling
+     * 
+     * See eVTOL_Sim_T::set_fault_importance_rate. When every eVTOL samples
+     * at the tilted rate, fault totals are reported both raw and
+     * likelihood-ratio weighted.
+     * 
+     * @param tilted_prob_per_hr - Tilted fault probability per hour (<= 0 to disable)
+     * @param tilted_index - Index of the only eVTOL sampling at the tilted rate (default all)
+     */
+    void set_fault_importance_rate(float tilted_prob_per_hr, int tilted_index = -1);
+
+    /**
+     * @brief Ground eVTOLs after faulty flights, into a pool of maintenance bays
+     * 
+     * From now on, an eVTOL that faulted during a flight may be grounded when
+     * it lands (see MaintenanceBay_T::set_ground_prob). It then queues for a
+     * bay in landing order, is serviced for a random time and goes on to
+     * charge. Bays are assigned and released from the pool's event heaps, so
+     * the cost is O(log n) per grounding. Fast-forwarding is then limited to
+     * runs with a charger per eVTOL, as serviced eVTOLs rejoin the chargers
+     * at times its contention check can't predict.
+     * 
+     * @param num_bays - Number of maintenance bays
+     * @return shared_ptr<MaintenanceBay> - Bay pool, to configure service times
+     */
+    shared_ptr<MaintenanceBay> enable_maintenance(int num_bays);
+
+    /**
+     * @brief Get the fraction of vehicle time one company spent not grounded
+     * 
+     * @param company - Company designation
+     * @return float - Availability, since t=0 (1 if the company has no eVTOLs)
+     */
+    float get_availability(VTOL_Comp_e company);
+
+    /**
+     * @brief Print groundings, time waiting for and in maintenance, and
+     * availability per company
+     */
+    void display_maintenance_stats();
+
+    /**
+     * @brief Record the charger pool's power draw from now on
+     * 
+     * Every charging session (battery capacity / charge time, from start
+     * to end of charge) is added to a PowerTimeline, committed each tick,
+     * for O(log n) peak/average/energy queries over any time range.
+     */
+    void enable_power_timeline();
+
+    /**
+     * @brief Get the power-draw timeline
+     * 
+     * @return shared_ptr<PowerTimeline> - Timeline, null unless enabled
+     */
+    shared_ptr<PowerTimeline> get_power_timeline();
+
+    /**
+     * @brief Print energy, average and peak power draw since recording started
+     * 
+     * Includes the peak demand, i.e. the highest average draw over any
+     * DEMAND_WINDOW_HR window aligned to the recording start
+     */
+    void display_power_stats();
+
+    /**
+     * @brief Get the configuration and per-company results of the last run
+     * 
+     * @return RunRecord_t - One row for a ResultsArchiveWriter
+     */
+    RunRecord_t get_run_record();
+
+    /**
+     * @brief Get the total number of eVTOLs
+     * 
+     * @return int - Number of eVTOLs simulated
+     */
+    int get_num_vtols();
+
+    /**
+     * @brief Get the current sim time
+     * 
+     * sim_flight stops on the first tick at or past 99.5% of the requested
+     * duration, so this is what a run actually covered (when started at 0)
+     * 
+     * @return float - Timestamp of the last tick processed (in hours)
+     */
+    float get_timestamp();
+
+    /**
+     * @brief Publish live metrics to shared memory during runs
+     * 
+     * Every publish_interval_ticks ticks, the sim time, percent complete,
+     * state counts per company, charger occupancy, wait queue length and
+     * ticks/sec are written to a seqlock-guarded shared memory page that
+     * tools/metrics_reader can watch. Gathering state counts is O(eVTOLs),
+     * so the interval should be large relative to fleet size.
+     * 
+     * @param publish_interval_ticks - Ticks between publishes
+     * @param name - Shared memory segment name
+     * @return true - If the segment was created
+     * @return false - If shared memory is unavailable or the segment already exists (metrics disabled)
+     */
+    bool enable_live_metrics(int publish_interval_ticks = 1000, const char* name = LIVE_METRICS_SHM_NAME);
+
+    /**
+     * @brief Get all eVTOL instances for one company
+     * 
+     * @param company - Company designation
+     * @return const vector<shared_ptr<eVTOL_Sim>>& - eVTOLs of that company
+     */
+    const vector<shared_ptr<eVTOL_Sim>>& get_company_vtols(VTOL_Comp_e company);
 };
 
 #endif // _FLIGHT_SIM_
\ No newline at end of file
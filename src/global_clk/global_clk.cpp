@@ -1,35 +1,77 @@
 #include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <dual.h>
 #include "global_clk.h"
 
-GlobalClk::GlobalClk(float start_time, float hr_per_tick)
+template <typename T>
+GlobalClk_T<T>::GlobalClk_T(T start_time, T hr_per_tick)
 {
   // Set local variables and counters
-  this->curr_timestamp = start_time;
-  this->hr_per_tick    = hr_per_tick;
+  this->curr_timestamp  = start_time;
+  this->hr_per_tick     = hr_per_tick;
+  this->start_timestamp = start_time;
+  this->num_ticks       = 0;
 
   if (hr_per_tick <= 0) {
     throw std::runtime_error("Invalid hours-per-tick!");
   }
 }
 
-void GlobalClk::tick()
+template <typename T>
+void GlobalClk_T<T>::tick()
 {
   // Increment timestamp by hr_per_tick
-  curr_timestamp += hr_per_tick;
+  curr_timestamp = get_tick_timestamp(1);
+  ++num_ticks;
 }
 
-float GlobalClk::get_timestamp()
+template <typename T>
+T GlobalClk_T<T>::get_timestamp()
 {
   return curr_timestamp;
 }
 
-float GlobalClk::get_hr_per_tick()
+template <typename T>
+T GlobalClk_T<T>::get_hr_per_tick()
 {
   return hr_per_tick;
 }
 
-void GlobalClk::set_timestamp(float timestamp)
+template <typename T>
+void GlobalClk_T<T>::set_timestamp(T timestamp)
 {
   // Reset current timestamp and current tick to new value
-  curr_timestamp = timestamp;
-}
\ No newline at end of file
+  curr_timestamp  = timestamp;
+  start_timestamp = timestamp;
+  num_ticks       = 0;
+}
+
+template <typename T>
+T GlobalClk_T<T>::get_tick_timestamp(int64_t ticks)
+{
+  return start_timestamp + hr_per_tick * (float)(num_ticks + ticks);
+}
+
+template <typename T>
+int64_t GlobalClk_T<T>::ticks_until(T timestamp)
+{
+  // Estimate, then settle on the exact tick using the same arithmetic
+  // as get_tick_timestamp
+  double estimate = ceil(scalar_value(timestamp - curr_timestamp) / scalar_value(hr_per_tick));
+  int64_t ticks = (estimate < 1) ? 1 : (int64_t)estimate;
+  while (ticks > 1 && get_tick_timestamp(ticks - 1) >= timestamp) --ticks;
+  while (get_tick_timestamp(ticks) < timestamp) ++ticks;
+  return ticks;
+}
+
+template <typename T>
+void GlobalClk_T<T>::advance(int64_t ticks)
+{
+  curr_timestamp = get_tick_timestamp(ticks);
+  num_ticks     += ticks;
+}
+
+// Explicit instantiations for supported scalar types
+template class GlobalClk_T<float>;
+template class GlobalClk_T<Dual>;
\ No newline at end of file
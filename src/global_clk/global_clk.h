@@ -1,34 +1,43 @@
 #ifndef _GLOBAL_CLK_
 #define _GLOBAL_CLK_
 
+#include <cstdint>
+
 // Simple class for synchronizing all sim instances
-class GlobalClk {
+// Templated over scalar type; instantiated for float and Dual
+template <typename T>
+class GlobalClk_T {
   private:
-    float curr_timestamp;           // Current timestamp
-    float hr_per_tick;              // Hour incremented per tick
+    T curr_timestamp;           // Current timestamp
+    T hr_per_tick;              // Hour incremented per tick
+    T start_timestamp;          // Timestamp at tick 0
+    int64_t num_ticks;          // Ticks since start_timestamp
   
   public:
     // Constructor
-    GlobalClk(float start_time, float hr_per_tick);
+    GlobalClk_T(T start_time, T hr_per_tick);
 
     /**
      * @brief Increment timestamp by tick amount, defined in constructor
+     * 
+     * Timestamps are computed from the tick count rather than accumulated,
+     * so they don't drift, and match get_tick_timestamp and advance exactly
      */
     void tick();
 
     /**
      * @brief Get the current timestamp
      * 
-     * @return float - timestamp value (in hours)
+     * @return T - timestamp value (in hours)
      */
-    float get_timestamp();
+    T get_timestamp();
 
     /**
      * @brief Get the number of hours incremented per tick
      * 
-     * @return float - Hours passed per call to tick()
+     * @return T - Hours passed per call to tick()
      */
-    float get_hr_per_tick();
+    T get_hr_per_tick();
 
     /**
      * @brief Force the timestamp to the given value.
@@ -37,7 +46,37 @@ class GlobalClk {
      * 
      * @param timestamp - Desired timestamp value
      */
-    void set_timestamp(float timestamp);
+    void set_timestamp(T timestamp);
+
+    /**
+     * @brief Get the timestamp a number of ticks from now, without ticking
+     * 
+     * Same value tick() would reach after that many calls
+     * 
+     * @param ticks - Number of ticks ahead
+     * @return T - Timestamp after that many ticks (in hours)
+     */
+    T get_tick_timestamp(int64_t ticks);
+
+    /**
+     * @brief Get the number of ticks until the given timestamp is reached
+     * 
+     * I.e. the first tick (at least one from now) whose timestamp, as per
+     * get_tick_timestamp, is at or past the given one
+     * 
+     * @param timestamp - Target timestamp (in hours)
+     * @return int64_t - Ticks from now
+     */
+    int64_t ticks_until(T timestamp);
+
+    /**
+     * @brief Advance timestamp by several ticks at once
+     * 
+     * @param ticks - Number of ticks to advance
+     */
+    void advance(int64_t ticks);
 };
 
+typedef GlobalClk_T<float> GlobalClk;
+
 #endif // _GLOBAL_CLK_
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include <atomic>
+#include <cstring>
+#include <new>
+#include "live_metrics.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Reader retries before giving up on a busy writer
+#define READ_MAX_RETRIES (1000)
+
+LiveMetricsPublisher::LiveMetricsPublisher(const char* name)
+{
+  page = nullptr;
+  strncpy(this->name, name, sizeof(this->name) - 1);
+  this->name[sizeof(this->name) - 1] = '\0';
+
+#ifndef _WIN32
+  // Never take over an existing segment; it may belong to a live run
+  int fd = shm_open(this->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) return;
+
+  bool mapped = false;
+  if (ftruncate(fd, sizeof(LiveMetricsPage_t)) == 0) {
+    void* addr = mmap(nullptr, sizeof(LiveMetricsPage_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr != MAP_FAILED) {
+      page = new (addr) LiveMetricsPage_t();
+      page->seq.store(0, std::memory_order_relaxed);
+      memset(&page->data, 0, sizeof(page->data));
+      page->version = LIVE_METRICS_VERSION;
+      // Magic written last, so readers never see a half-initialized page
+      std::atomic_thread_fence(std::memory_order_release);
+      page->magic = LIVE_METRICS_MAGIC;
+      mapped = true;
+    }
+  }
+  // Mapping stays valid after the descriptor is closed
+  close(fd);
+  // The segment is ours, so don't leave it behind half set up
+  if (!mapped) shm_unlink(this->name);
+#endif
+}
+
+LiveMetricsPublisher::~LiveMetricsPublisher()
+{
+#ifndef _WIN32
+  if (page == nullptr) return;
+  munmap(page, sizeof(LiveMetricsPage_t));
+  shm_unlink(name);
+#endif
+}
+
+bool LiveMetricsPublisher::is_open()
+{
+  return page != nullptr;
+}
+
+void LiveMetricsPublisher::publish(const LiveMetricsData_t& data)
+{
+  if (page == nullptr) return;
+
+  // Single writer, so a relaxed load of our own counter is enough
+  uint32_t seq = page->seq.load(std::memory_order_relaxed);
+  page->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  memcpy(&page->data, &data, sizeof(data));
+
+  page->seq.store(seq + 2, std::memory_order_release);
+}
+
+LiveMetricsReader::LiveMetricsReader(const char* name)
+{
+  page = nullptr;
+
+#ifndef _WIN32
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0) return;
+
+  void* addr = mmap(nullptr, sizeof(LiveMetricsPage_t), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) return;
+
+  page = static_cast<LiveMetricsPage_t*>(addr);
+  if (page->magic != LIVE_METRICS_MAGIC || page->version != LIVE_METRICS_VERSION) {
+    munmap(addr, sizeof(LiveMetricsPage_t));
+    page = nullptr;
+  }
+#else
+  (void)name;
+#endif
+}
+
+LiveMetricsReader::~LiveMetricsReader()
+{
+#ifndef _WIN32
+  if (page != nullptr) munmap(page, sizeof(LiveMetricsPage_t));
+#endif
+}
+
+bool LiveMetricsReader::is_open()
+{
+  return page != nullptr;
+}
+
+uint32_t LiveMetricsReader::get_sequence()
+{
+  if (page == nullptr) return 0;
+  return page->seq.load(std::memory_order_acquire);
+}
+
+bool LiveMetricsReader::read(LiveMetricsData_t& out)
+{
+  if (page == nullptr) return false;
+
+  for (int retry = 0; retry < READ_MAX_RETRIES; retry++) {
+    uint32_t seq_start = page->seq.load(std::memory_order_acquire);
+    // Odd means the writer is mid-update
+    if (seq_start & 1) continue;
+
+    memcpy(&out, &page->data, sizeof(out));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (page->seq.load(std::memory_order_relaxed) == seq_start) return true;
+  }
+
+  return false;
+}
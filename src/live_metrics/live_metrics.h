@@ -0,0 +1,129 @@
+/**
+ * @brief Live metrics page in shared memory
+ * 
+ * The sim thread publishes a snapshot of its progress into a POSIX shared
+ * memory segment guarded by a seqlock. Publishing never blocks and makes no
+ * syscalls (only the segment setup/teardown does), so external monitors can
+ * watch long runs at essentially no cost to the sim loop.
+ * 
+ * NOTE: not supported on Windows; the publisher simply stays closed there.
+ */
+
+#ifndef _LIVE_METRICS_H_
+#define _LIVE_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <types.h>
+
+// Default shared memory segment name
+#define LIVE_METRICS_SHM_NAME "/evtol_sim_metrics"
+
+// Page identification, checked by readers
+#define LIVE_METRICS_MAGIC   (0x45564D53) // "EVMS"
+#define LIVE_METRICS_VERSION (2)
+
+// Snapshot of sim progress
+typedef struct LiveMetricsData_t {
+  double sim_time_hr;                               // Current sim timestamp
+  double end_time_hr;                               // Timestamp the run ends at
+  double pct_complete;                              // Percent of run complete
+  double ticks_per_sec;                             // Wall-clock tick rate since last publish
+  int64_t tick_count;                               // Ticks processed this run
+  int32_t state_counts[MAX_COMPANIES][MAX_STATES];  // eVTOLs per company per state
+  int32_t chargers_in_use;                          // Chargers currently occupied
+  int32_t num_chargers;                             // Chargers in pool
+  int32_t wait_q_len;                               // eVTOLs waiting for a charger
+  int32_t running;                                  // Nonzero while a run is in progress
+} LiveMetricsData_t;
+
+// Shared memory layout
+typedef struct LiveMetricsPage_t {
+  uint32_t magic;
+  uint32_t version;
+  std::atomic<uint32_t> seq;  // Seqlock counter, odd while a write is in progress
+  LiveMetricsData_t data;
+} LiveMetricsPage_t;
+
+class LiveMetricsPublisher {
+  private:
+    LiveMetricsPage_t* page;  // Mapped page, null if not open
+    char name[64];            // Segment name, for unlinking
+
+  public:
+    /**
+     * @brief Create the shared memory segment and map it
+     * 
+     * Fails (is_open() is false) if the segment already exists, so two runs
+     * never publish into the same page and a live run's segment is never
+     * unlinked from under its readers. A segment left by a crashed run has
+     * to be removed by hand (/dev/shm on Linux) or another name used.
+     * 
+     * @param name - Segment name (must start with '/')
+     */
+    LiveMetricsPublisher(const char* name = LIVE_METRICS_SHM_NAME);
+
+    /**
+     * @brief Unmap and remove the shared memory segment
+     */
+    ~LiveMetricsPublisher();
+
+    /**
+     * @brief Check if the segment was created successfully
+     * 
+     * @return true - If publishing will be visible to readers
+     * @return false - If setup failed or the segment exists (publish is then a no-op)
+     */
+    bool is_open();
+
+    /**
+     * @brief Publish a snapshot (seqlock write, wait-free)
+     * 
+     * @param data - Snapshot to copy into the page
+     */
+    void publish(const LiveMetricsData_t& data);
+};
+
+class LiveMetricsReader {
+  private:
+    LiveMetricsPage_t* page;  // Mapped page, null if not open
+
+  public:
+    /**
+     * @brief Map an existing metrics segment read-only
+     * 
+     * @param name - Segment name (must start with '/')
+     */
+    LiveMetricsReader(const char* name = LIVE_METRICS_SHM_NAME);
+
+    /**
+     * @brief Unmap the segment
+     */
+    ~LiveMetricsReader();
+
+    /**
+     * @brief Check if the segment was mapped and has a matching layout
+     * 
+     * @return true - If reads are possible
+     * @return false - If the segment doesn't exist or is incompatible
+     */
+    bool is_open();
+
+    /**
+     * @brief Get the seqlock counter
+     * 
+     * @return uint32_t - 0 until the first publish, then twice the number of publishes (odd mid-write)
+     */
+    uint32_t get_sequence();
+
+    /**
+     * @brief Read a consistent snapshot, retrying while a write is in progress
+     * 
+     * @param out - Snapshot destination
+     * @return true - If a consistent snapshot was read
+     * @return false - If the reader is not open or gave up after many retries
+     */
+    bool read(LiveMetricsData_t& out);
+};
+
+#endif // _LIVE_METRICS_H_
@@ -0,0 +1,153 @@
+#include "maintenance_bay.h"
+#include <evtol_sim.h>
+#include <dual.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+template <typename T>
+MaintenanceBay_T<T>::MaintenanceBay_T(int num_bays)
+{
+  if (num_bays <= 0) {
+    throw std::runtime_error("Need at least one maintenance bay!");
+  }
+
+  this->num_bays = num_bays;
+  num_requests   = 0;
+  ground_prob    = 1;
+
+  // Every bay starts free
+  for (int bay = 0; bay < num_bays; bay++) bay_free.push(-INFINITY);
+
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    num_serviced[company]    = 0;
+    service_mean_hr[company] = DEFAULT_SERVICE_TIME_HR;
+    service_cv[company]      = DEFAULT_SERVICE_CV;
+  }
+}
+
+template <typename T>
+void MaintenanceBay_T<T>::set_service_time(VTOL_Comp_e company, float mean_hr, float cv)
+{
+  if (mean_hr <= 0 || cv < 0) {
+    throw std::runtime_error("Invalid service time distribution!");
+  }
+  service_mean_hr[company] = mean_hr;
+  service_cv[company]      = cv;
+}
+
+template <typename T>
+void MaintenanceBay_T<T>::set_ground_prob(float prob)
+{
+  if (prob < 0 || prob > 1) {
+    throw std::runtime_error("Grounding probability must be in [0, 1]!");
+  }
+  ground_prob = prob;
+}
+
+template <typename T>
+void MaintenanceBay_T<T>::seed(unsigned int seed)
+{
+  rand_gen.seed(seed);
+}
+
+template <typename T>
+bool MaintenanceBay_T<T>::should_ground(int num_faults)
+{
+  if (num_faults <= 0) return false;
+  // Grounded unless every fault is let through
+  std::bernoulli_distribution ground_dist(1 - pow(1 - ground_prob, num_faults));
+  return ground_dist(rand_gen);
+}
+
+template <typename T>
+double MaintenanceBay_T<T>::_draw_service_hr(VTOL_Comp_e company)
+{
+  double mean = service_mean_hr[company];
+  double cv   = service_cv[company];
+  if (cv == 0) return mean;
+
+  // Shape 1/cv^2 and scale mean*cv^2 give the requested mean and CV
+  std::gamma_distribution<double> service_dist(1 / (cv * cv), mean * cv * cv);
+  return service_dist(rand_gen);
+}
+
+template <typename T>
+void MaintenanceBay_T<T>::request_bay(eVTOL_Sim_T<T>* vtol_ptr, T timestamp)
+{
+  MaintenanceEntry_T<T> entry = {scalar_value(timestamp), num_requests++, vtol_ptr};
+  wait_q.push(entry);
+}
+
+template <typename T>
+void MaintenanceBay_T<T>::process(T curr_timestamp, std::vector<eVTOL_Sim_T<T>*>* released)
+{
+  double now = scalar_value(curr_timestamp);
+
+  // Earliest free bay to the earliest landing; a bay freed by a service
+  // ending before now goes straight back into the heap for the next one.
+  // Landings queued ahead of time (by fast-forwarding) wait for their turn
+  while (!wait_q.empty() && wait_q.top().timestamp <= now && bay_free.top() <= now)
+  {
+    MaintenanceEntry_T<T> entry = wait_q.top();
+    wait_q.pop();
+
+    double start = std::max(entry.timestamp, bay_free.top());
+    double end   = start + _draw_service_hr(entry.vtol->get_company());
+    bay_free.pop();
+    bay_free.push(end);
+
+    entry.vtol->start_maintenance(start);
+    ++num_serviced[entry.vtol->get_company()];
+
+    entry.timestamp = end;
+    in_service.push(entry);
+  }
+
+  // Release everything serviced by now, in order
+  while (!in_service.empty() && in_service.top().timestamp <= now)
+  {
+    MaintenanceEntry_T<T> entry = in_service.top();
+    in_service.pop();
+    entry.vtol->end_maintenance(entry.timestamp);
+    if (released != nullptr) released->push_back(entry.vtol);
+  }
+}
+
+template <typename T>
+double MaintenanceBay_T<T>::get_next_event_timestamp()
+{
+  double next = INFINITY;
+  if (!in_service.empty()) next = in_service.top().timestamp;
+  if (!wait_q.empty()) next = std::min(next, std::max(wait_q.top().timestamp, bay_free.top()));
+  return next;
+}
+
+template <typename T>
+int MaintenanceBay_T<T>::get_bays_in_use()
+{
+  return in_service.size();
+}
+
+template <typename T>
+int MaintenanceBay_T<T>::get_num_bays()
+{
+  return num_bays;
+}
+
+template <typename T>
+int MaintenanceBay_T<T>::get_wait_q_len()
+{
+  return wait_q.size();
+}
+
+template <typename T>
+int64_t MaintenanceBay_T<T>::get_num_serviced(VTOL_Comp_e company)
+{
+  return num_serviced[company];
+}
+
+// Explicit instantiations for supported scalar types
+template class MaintenanceBay_T<float>;
+template class MaintenanceBay_T<Dual>;
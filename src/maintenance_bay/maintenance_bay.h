@@ -0,0 +1,179 @@
+/**
+ * @brief Maintenance bay pool, modeled after Charger
+ *
+ * eVTOLs that faulted during a flight may be grounded when they land. A
+ * grounded eVTOL queues for one of a limited number of bays, is serviced for
+ * a random (gamma distributed, per company) time, then goes on to charge.
+ *
+ * The pool keeps the queue as a heap ordered by landing time, a heap of the
+ * times each bay frees up, and a heap of service completions. Each tick only
+ * pops what is due, so bay assignment and release are O(log n) regardless of
+ * fleet size. Grounded eVTOLs only check their blocked flag each tick.
+ */
+
+#ifndef _MAINTENANCE_BAY_H_
+#define _MAINTENANCE_BAY_H_
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+#include <types.h>
+#include <evtol_sim.h>
+
+// Included here due to circular dependency
+template <typename T> class eVTOL_Sim_T;
+
+// Default service time per grounding (in hours) and its coefficient of variation
+#define DEFAULT_SERVICE_TIME_HR (2.0)
+#define DEFAULT_SERVICE_CV      (0.5)
+
+// Grounded eVTOL waiting for, or in, a bay
+template <typename T>
+struct MaintenanceEntry_T {
+  double timestamp;       // Landing time (queue) or service end (in service)
+  int64_t seq;            // Request order, to break timestamp ties
+  eVTOL_Sim_T<T>* vtol;
+};
+
+// Orders entry heaps by time, then request order
+template <typename T>
+struct MaintenanceEntryLater {
+  bool operator()(const MaintenanceEntry_T<T>& a, const MaintenanceEntry_T<T>& b) const {
+    if (a.timestamp != b.timestamp) return a.timestamp > b.timestamp;
+    return a.seq > b.seq;
+  }
+};
+
+// Templated over scalar type; instantiated for float and Dual
+template <typename T>
+class MaintenanceBay_T {
+  private:
+    typedef std::priority_queue<MaintenanceEntry_T<T>, std::vector<MaintenanceEntry_T<T>>, MaintenanceEntryLater<T>> EntryHeap;
+
+    int num_bays;           // Total number of bays
+    int64_t num_requests;   // Requests so far, for tie-breaking
+    int64_t num_serviced[MAX_COMPANIES]; // Services started per company
+
+    EntryHeap wait_q;       // Grounded eVTOLs by landing time
+    EntryHeap in_service;   // Serviced eVTOLs by service end
+    std::priority_queue<double, std::vector<double>, std::greater<double>> bay_free; // Time each bay frees up
+
+    // Grounding and service time randomization
+    std::default_random_engine rand_gen;
+    float ground_prob;                          // Probability a single fault grounds the eVTOL
+    float service_mean_hr[MAX_COMPANIES];
+    float service_cv[MAX_COMPANIES];
+
+    /**
+     * @brief Draw a service time for one eVTOL
+     *
+     * @param company - Company designation
+     * @return double - Service time (in hours)
+     */
+    double _draw_service_hr(VTOL_Comp_e company);
+
+  public:
+    /**
+     * @brief Construct a new Maintenance Bay object
+     *
+     * @param num_bays - Number of bays available
+     */
+    MaintenanceBay_T(int num_bays);
+
+    /**
+     * @brief Set the service time distribution of one company
+     *
+     * Gamma distributed with the given mean and coefficient of variation
+     * (1 is exponential, 0 is a fixed time)
+     *
+     * @param company - Company designation
+     * @param mean_hr - Mean service time (in hours)
+     * @param cv - Coefficient of variation
+     */
+    void set_service_time(VTOL_Comp_e company, float mean_hr, float cv);
+
+    /**
+     * @brief Set the probability a single fault grounds the eVTOL at landing
+     *
+     * @param prob - Probability per fault (default 1, i.e. any fault grounds)
+     */
+    void set_ground_prob(float prob);
+
+    /**
+     * @brief Seed the grounding and service time generator
+     *
+     * @param seed - Seed value
+     */
+    void seed(unsigned int seed);
+
+    /**
+     * @brief Draw whether a landing eVTOL is grounded
+     *
+     * @param num_faults - Faults during the flight
+     * @return true - If any fault grounds it
+     * @return false - If it can go on to charge
+     */
+    bool should_ground(int num_faults);
+
+    /**
+     * @brief Queue a grounded eVTOL for a bay
+     *
+     * @param vtol_ptr - Pointer to grounded VTOL instance
+     * @param timestamp - Landing time (in hours)
+     */
+    void request_bay(eVTOL_Sim_T<T>* vtol_ptr, T timestamp);
+
+    /**
+     * @brief Assign free bays and release serviced eVTOLs up to a timestamp
+     *
+     * Called once per tick, after every eVTOL has ticked (so all landings up
+     * to the timestamp are queued). Bays go to eVTOLs in landing order, each
+     * starting service once both it and a bay are available.
+     *
+     * @param curr_timestamp - Current tick timestamp
+     * @param released - If set, serviced eVTOLs are appended to it
+     */
+    void process(T curr_timestamp, std::vector<eVTOL_Sim_T<T>*>* released = nullptr);
+
+    /**
+     * @brief Get the time of the next service start or end
+     *
+     * @return double - Earliest timestamp process() would act on (infinity if none)
+     */
+    double get_next_event_timestamp();
+
+    /**
+     * @brief Get the number of bays currently in use
+     *
+     * @return int - Bays in use
+     */
+    int get_bays_in_use();
+
+    /**
+     * @brief Get the total number of bays
+     *
+     * @return int - Bays in pool
+     */
+    int get_num_bays();
+
+    /**
+     * @brief Get the number of grounded eVTOLs waiting for a bay
+     *
+     * @return int - Wait queue length
+     */
+    int get_wait_q_len();
+
+    /**
+     * @brief Get the number of services started for one company
+     *
+     * @param company - Company designation
+     * @return int64_t - Services started
+     */
+    int64_t get_num_serviced(VTOL_Comp_e company);
+};
+
+typedef MaintenanceBay_T<float> MaintenanceBay;
+
+#endif // _MAINTENANCE_BAY_H_
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "power_timeline.h"
+
+// Smallest segment tree allocated, in leaves
+#define MIN_TREE_CAPACITY (1024)
+
+// Levels below this are residue from adding and removing the same sessions
+// in a different order, and are treated as an idle pool
+#define IDLE_LEVEL_KW (1e-6)
+
+PowerTimeline::PowerTimeline()
+{
+  committed_timestamp = -INFINITY;
+  tree_capacity       = 0;
+  num_sessions        = 0;
+}
+
+void PowerTimeline::add_session(double start_timestamp, double end_timestamp, double power_kw)
+{
+  if (start_timestamp < committed_timestamp) {
+    throw std::runtime_error("Session starts before committed timestamp!");
+  }
+
+  PowerStep_t start = {start_timestamp, power_kw};
+  PowerStep_t end   = {end_timestamp, -power_kw};
+  pending.push(start);
+  pending.push(end);
+  ++num_sessions;
+}
+
+void PowerTimeline::commit(double timestamp)
+{
+  while (!pending.empty() && pending.top().timestamp <= timestamp) {
+    _append_step(pending.top());
+    pending.pop();
+  }
+  if (timestamp > committed_timestamp) committed_timestamp = timestamp;
+}
+
+void PowerTimeline::_append_step(const PowerStep_t& step)
+{
+  // Steps arrive in time order, so a repeat timestamp adjusts the last segment
+  if (!breakpoints.empty() && step.timestamp <= breakpoints.back()) {
+    double level = level_kw.back() + step.delta_kw;
+    level_kw.back() = (level < IDLE_LEVEL_KW) ? 0 : level;
+    _set_tree_level(level_kw.size() - 1, level_kw.back());
+    return;
+  }
+
+  double prev_level  = level_kw.empty() ? 0 : level_kw.back();
+  double prev_energy = energy_kwh.empty() ? 0 : energy_kwh.back() + prev_level * (step.timestamp - breakpoints.back());
+  double level       = prev_level + step.delta_kw;
+
+  breakpoints.push_back(step.timestamp);
+  energy_kwh.push_back(prev_energy);
+  level_kw.push_back((level < IDLE_LEVEL_KW) ? 0 : level);
+  _set_tree_level(level_kw.size() - 1, level_kw.back());
+}
+
+void PowerTimeline::_set_tree_level(size_t index, double level)
+{
+  // Out of leaves: double the capacity and rebuild, amortized O(1) per append
+  if (index >= tree_capacity) {
+    tree_capacity = std::max(tree_capacity * 2, (size_t)MIN_TREE_CAPACITY);
+    while (index >= tree_capacity) tree_capacity *= 2;
+
+    tree.assign(2 * tree_capacity, 0);
+    std::copy(level_kw.begin(), level_kw.end(), tree.begin() + tree_capacity);
+    for (size_t pos = tree_capacity - 1; pos >= 1; pos--) {
+      tree[pos] = std::max(tree[2 * pos], tree[2 * pos + 1]);
+    }
+    return;
+  }
+
+  size_t pos = tree_capacity + index;
+  tree[pos] = level;
+  for (pos /= 2; pos >= 1; pos /= 2) {
+    tree[pos] = std::max(tree[2 * pos], tree[2 * pos + 1]);
+  }
+}
+
+int64_t PowerTimeline::_segment_at(double timestamp)
+{
+  return (std::upper_bound(breakpoints.begin(), breakpoints.end(), timestamp) - breakpoints.begin()) - 1;
+}
+
+double PowerTimeline::_energy_until(double timestamp)
+{
+  int64_t segment = _segment_at(timestamp);
+  if (segment < 0) return 0;
+  return energy_kwh[segment] + level_kw[segment] * (timestamp - breakpoints[segment]);
+}
+
+double PowerTimeline::get_peak_kw(double start_timestamp, double end_timestamp)
+{
+  end_timestamp = std::min(end_timestamp, committed_timestamp);
+  if (end_timestamp < start_timestamp) return 0;
+
+  // Segments overlapping [start, end); a breakpoint exactly at the end
+  // starts a segment outside the range
+  int64_t first = _segment_at(start_timestamp);
+  int64_t last  = (std::lower_bound(breakpoints.begin(), breakpoints.end(), end_timestamp) - breakpoints.begin()) - 1;
+  if (last < first) last = first;
+  if (last < 0) return 0;
+  if (first < 0) first = 0; // Idle before the first session
+
+  // Iterative max over leaves [first, last]
+  double peak = 0;
+  for (size_t lo = first + tree_capacity, hi = last + tree_capacity + 1; lo < hi; lo /= 2, hi /= 2) {
+    if (lo & 1) peak = std::max(peak, tree[lo++]);
+    if (hi & 1) peak = std::max(peak, tree[--hi]);
+  }
+  return peak;
+}
+
+double PowerTimeline::get_energy_kwh(double start_timestamp, double end_timestamp)
+{
+  end_timestamp = std::min(end_timestamp, committed_timestamp);
+  if (end_timestamp <= start_timestamp) return 0;
+  return _energy_until(end_timestamp) - _energy_until(start_timestamp);
+}
+
+double PowerTimeline::get_avg_kw(double start_timestamp, double end_timestamp)
+{
+  end_timestamp = std::min(end_timestamp, committed_timestamp);
+  if (end_timestamp <= start_timestamp) return 0;
+  return get_energy_kwh(start_timestamp, end_timestamp) / (end_timestamp - start_timestamp);
+}
+
+double PowerTimeline::get_peak_demand_kw(double start_timestamp, double end_timestamp, double window_hr)
+{
+  end_timestamp = std::min(end_timestamp, committed_timestamp);
+  if (window_hr <= 0) {
+    throw std::runtime_error("Demand window must be positive!");
+  }
+
+  // One O(log n) query per window; window starts are computed from the
+  // range start so they don't drift
+  double peak = 0;
+  for (int64_t i = 0; start_timestamp + i * window_hr < end_timestamp; i++) {
+    double window = start_timestamp + i * window_hr;
+    peak = std::max(peak, get_avg_kw(window, std::min(window + window_hr, end_timestamp)));
+  }
+  return peak;
+}
+
+double PowerTimeline::get_committed_timestamp()
+{
+  return committed_timestamp;
+}
+
+int64_t PowerTimeline::get_num_sessions()
+{
+  return num_sessions;
+}
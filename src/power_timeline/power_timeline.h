@@ -0,0 +1,165 @@
+/**
+ * @brief Power-draw timeline for a charger pool
+ *
+ * Charging sessions draw constant power (battery capacity / charge time)
+ * from their start to their end. The pool's total draw is piecewise
+ * constant, stored as sorted breakpoints with a max segment tree over the
+ * segment levels and a prefix array of energy up to each breakpoint. Peak,
+ * average and energy queries over any time range are then O(log n).
+ *
+ * Sessions are reported as they start, out of time order across vehicles
+ * (and with their end in the future), so their start/end steps are held in
+ * a pending heap and only appended to the timeline once the caller commits
+ * up to a timestamp no later session can start before.
+ */
+
+#ifndef _POWER_TIMELINE_H_
+#define _POWER_TIMELINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+// Pending power step
+typedef struct PowerStep_t {
+  double timestamp; // When the step occurs (in hours)
+  double delta_kw;  // Change in power draw
+} PowerStep_t;
+
+// Orders the pending heap by time
+struct PowerStepLater {
+  bool operator()(const PowerStep_t& a, const PowerStep_t& b) const {
+    return a.timestamp > b.timestamp;
+  }
+};
+
+class PowerTimeline {
+  private:
+    // Committed timeline: level_kw[i] applies from breakpoints[i] to breakpoints[i + 1]
+    std::vector<double> breakpoints;  // Strictly increasing timestamps
+    std::vector<double> level_kw;     // Power draw per segment
+    std::vector<double> energy_kwh;   // Energy drawn before each breakpoint
+    double committed_timestamp;       // Timeline is final up to here
+
+    // Max segment tree over level_kw, leaves at [tree_capacity, 2 * tree_capacity)
+    std::vector<double> tree;
+    size_t tree_capacity;
+
+    // Steps not committed yet
+    std::priority_queue<PowerStep_t, std::vector<PowerStep_t>, PowerStepLater> pending;
+    int64_t num_sessions;
+
+    /**
+     * @brief Append a step to the committed timeline (in time order)
+     *
+     * @param step - Power step
+     */
+    void _append_step(const PowerStep_t& step);
+
+    /**
+     * @brief Set a segment level in the max tree, growing it if needed
+     *
+     * @param index - Segment index
+     * @param level - Power draw
+     */
+    void _set_tree_level(size_t index, double level);
+
+    /**
+     * @brief Get the index of the segment containing a timestamp
+     *
+     * @param timestamp - Time (in hours)
+     * @return int64_t - Segment index, or -1 before the first breakpoint
+     */
+    int64_t _segment_at(double timestamp);
+
+    /**
+     * @brief Get the energy drawn from the first breakpoint up to a timestamp
+     *
+     * @param timestamp - Time (in hours), at most the committed timestamp
+     * @return double - Energy (in kWh)
+     */
+    double _energy_until(double timestamp);
+
+  public:
+    /**
+     * @brief Construct an empty timeline
+     */
+    PowerTimeline();
+
+    /**
+     * @brief Record a charging session
+     *
+     * @param start_timestamp - Session start (in hours), not before the committed timestamp
+     * @param end_timestamp - Session end (in hours)
+     * @param power_kw - Constant power drawn
+     */
+    void add_session(double start_timestamp, double end_timestamp, double power_kw);
+
+    /**
+     * @brief Commit all steps up to a timestamp to the timeline
+     *
+     * The caller guarantees no session added later starts before it
+     *
+     * @param timestamp - Time (in hours) the timeline is final up to
+     */
+    void commit(double timestamp);
+
+    /**
+     * @brief Get the peak power draw over a time range
+     *
+     * Ranges are clipped to the committed part of the timeline
+     *
+     * @param start_timestamp - Range start (in hours)
+     * @param end_timestamp - Range end (in hours)
+     * @return double - Peak draw (in kW)
+     */
+    double get_peak_kw(double start_timestamp, double end_timestamp);
+
+    /**
+     * @brief Get the energy drawn over a time range
+     *
+     * @param start_timestamp - Range start (in hours)
+     * @param end_timestamp - Range end (in hours)
+     * @return double - Energy (in kWh)
+     */
+    double get_energy_kwh(double start_timestamp, double end_timestamp);
+
+    /**
+     * @brief Get the average power draw over a time range
+     *
+     * @param start_timestamp - Range start (in hours)
+     * @param end_timestamp - Range end (in hours)
+     * @return double - Average draw (in kW), 0 for an empty range
+     */
+    double get_avg_kw(double start_timestamp, double end_timestamp);
+
+    /**
+     * @brief Get the peak demand over a time range
+     *
+     * The highest average draw over consecutive windows from the range
+     * start; the last window is clipped to the range end
+     *
+     * @param start_timestamp - Range start (in hours)
+     * @param end_timestamp - Range end (in hours)
+     * @param window_hr - Demand window length (in hours)
+     * @return double - Peak demand (in kW)
+     */
+    double get_peak_demand_kw(double start_timestamp, double end_timestamp, double window_hr);
+
+    /**
+     * @brief Get the timestamp the timeline is committed up to
+     *
+     * @return double - Time (in hours)
+     */
+    double get_committed_timestamp();
+
+    /**
+     * @brief Get the number of sessions recorded
+     *
+     * @return int64_t - Sessions, committed or not
+     */
+    int64_t get_num_sessions();
+};
+
+#endif // _POWER_TIMELINE_H_
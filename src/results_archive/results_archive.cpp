@@ -0,0 +1,316 @@
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "results_archive.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Bytes per value of each column type
+static size_t column_width(ColumnType_e type)
+{
+  return (type == COL_INT64) ? sizeof(int64_t) : sizeof(int32_t);
+}
+
+// Expected header of a column file
+static ColumnHeader_t column_header(ColumnType_e type)
+{
+  ColumnHeader_t header = {};
+  header.magic   = RESULTS_ARCHIVE_MAGIC;
+  header.version = RESULTS_ARCHIVE_VERSION;
+  header.type    = type;
+  header.width   = column_width(type);
+  return header;
+}
+
+// Path of a column file within an archive directory
+static std::string column_path(const char* dir, const ResultsColumn_t& column)
+{
+  return std::string(dir) + "/" + column.name + RESULTS_COLUMN_EXT;
+}
+
+// Build the column definitions, see results_archive_columns
+static std::vector<ResultsColumn_t> build_columns()
+{
+  std::vector<ResultsColumn_t> columns;
+
+  // Configuration
+  columns.push_back({"num_vtols",    COL_INT32, offsetof(RunRecord_t, num_vtols)});
+  columns.push_back({"num_chargers", COL_INT32, offsetof(RunRecord_t, num_chargers)});
+  columns.push_back({"tick_rate",    COL_FLOAT, offsetof(RunRecord_t, tick_rate)});
+  columns.push_back({"sim_time_hr",  COL_FLOAT, offsetof(RunRecord_t, sim_time_hr)});
+  columns.push_back({"seed",         COL_INT64, offsetof(RunRecord_t, seed)});
+
+  // Per-company metrics
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    std::string prefix = COMP_NAMES.at(static_cast<VTOL_Comp_e>(company));
+    for (char& c : prefix) c = tolower(c);
+    size_t base = offsetof(RunRecord_t, company_stats) + company * sizeof(CompanyStats_t);
+
+    columns.push_back({prefix + "_vtols",              COL_INT32, base + offsetof(CompanyStats_t, num_vtols)});
+    columns.push_back({prefix + "_flight_time_hr",     COL_FLOAT, base + offsetof(CompanyStats_t, avg_flight_time_hr)});
+    columns.push_back({prefix + "_flight_distance_mi", COL_FLOAT, base + offsetof(CompanyStats_t, avg_flight_distance_mi)});
+    columns.push_back({prefix + "_charging_time_hr",   COL_FLOAT, base + offsetof(CompanyStats_t, avg_charging_time_hr)});
+    columns.push_back({prefix + "_waiting_time_hr",    COL_FLOAT, base + offsetof(CompanyStats_t, avg_waiting_time_hr)});
+    columns.push_back({prefix + "_faults",             COL_INT32, base + offsetof(CompanyStats_t, total_faults)});
+    columns.push_back({prefix + "_passenger_miles",    COL_FLOAT, base + offsetof(CompanyStats_t, total_passenger_miles)});
+  }
+
+  return columns;
+}
+
+const std::vector<ResultsColumn_t>& results_archive_columns()
+{
+  static const std::vector<ResultsColumn_t> columns = build_columns();
+  return columns;
+}
+
+ResultsArchiveWriter::ResultsArchiveWriter(const char* dir)
+{
+  num_rows = 0;
+
+#ifndef _WIN32
+  // Fails harmlessly if the archive already exists
+  mkdir(dir, 0755);
+
+  const std::vector<ResultsColumn_t>& defs = results_archive_columns();
+  std::vector<off_t> sizes(defs.size(), 0);
+  std::vector<int64_t> rows(defs.size(), 0);
+  bool created = false;
+  for (size_t i = 0; i < defs.size(); i++)
+  {
+    std::string path = column_path(dir, defs[i]);
+    ColumnHeader_t header = column_header(defs[i].type);
+
+    FILE* file = fopen(path.c_str(), "r+b");
+    if (file == nullptr) {
+      file = fopen(path.c_str(), "w+b");
+      created = true;
+    }
+    if (file == nullptr) {
+      _close_all();
+      return;
+    }
+    files.push_back(file);
+
+    // A file too short for a header was never appended to; (re)write it
+    ColumnHeader_t existing;
+    if (fread(&existing, sizeof(existing), 1, file) != 1) {
+      if (ftruncate(fileno(file), 0) != 0 || fseeko(file, 0, SEEK_SET) != 0 ||
+          fwrite(&header, sizeof(header), 1, file) != 1 || fflush(file) != 0) {
+        _close_all();
+        return;
+      }
+    } else if (memcmp(&existing, &header, sizeof(header)) != 0) {
+      _close_all();
+      return;
+    }
+
+    if (fseeko(file, 0, SEEK_END) != 0) {
+      _close_all();
+      return;
+    }
+    sizes[i] = ftello(file);
+    rows[i]  = (sizes[i] - (off_t)sizeof(header)) / header.width;
+  }
+
+  int64_t min_rows = rows[0];
+  int64_t max_rows = rows[0];
+  for (int64_t column_rows : rows) {
+    if (column_rows < min_rows) min_rows = column_rows;
+    if (column_rows > max_rows) max_rows = column_rows;
+  }
+
+  // A column missing from a populated archive means a different layout,
+  // not an interrupted append; refuse rather than trim everything
+  if (created && max_rows > 0) {
+    _close_all();
+    return;
+  }
+
+  // Trim any partial row, and position every column at its end
+  for (size_t i = 0; i < defs.size(); i++)
+  {
+    off_t length = sizeof(ColumnHeader_t) + min_rows * column_width(defs[i].type);
+    if (sizes[i] != length && ftruncate(fileno(files[i]), length) != 0) {
+      _close_all();
+      return;
+    }
+    if (fseeko(files[i], 0, SEEK_END) != 0) {
+      _close_all();
+      return;
+    }
+  }
+  num_rows = min_rows;
+#endif
+}
+
+ResultsArchiveWriter::~ResultsArchiveWriter()
+{
+  _close_all();
+}
+
+void ResultsArchiveWriter::_close_all()
+{
+  for (FILE* file : files) fclose(file);
+  files.clear();
+}
+
+bool ResultsArchiveWriter::is_open()
+{
+  return !files.empty();
+}
+
+bool ResultsArchiveWriter::append(const RunRecord_t& record)
+{
+  if (files.empty()) return false;
+
+  const std::vector<ResultsColumn_t>& defs = results_archive_columns();
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+  bool ok = true;
+  for (size_t i = 0; i < defs.size(); i++) {
+    ok = (fwrite(bytes + defs[i].offset, column_width(defs[i].type), 1, files[i]) == 1) && ok;
+  }
+
+  if (ok) ++num_rows;
+  return ok;
+}
+
+bool ResultsArchiveWriter::flush()
+{
+  bool ok = true;
+  for (FILE* file : files) ok = (fflush(file) == 0) && ok;
+  return ok;
+}
+
+int64_t ResultsArchiveWriter::get_num_rows()
+{
+  return num_rows;
+}
+
+ResultsArchiveReader::ResultsArchiveReader(const char* dir)
+{
+  num_rows = 0;
+
+#ifndef _WIN32
+  const std::vector<ResultsColumn_t>& defs = results_archive_columns();
+  for (size_t i = 0; i < defs.size(); i++)
+  {
+    ColumnHeader_t header = column_header(defs[i].type);
+
+    int fd = open(column_path(dir, defs[i]).c_str(), O_RDONLY);
+    if (fd < 0) {
+      _unmap_all();
+      return;
+    }
+
+    struct stat info;
+    void* addr = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(header)) {
+      addr = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    // Mapping stays valid after the descriptor is closed
+    close(fd);
+    if (addr == MAP_FAILED) {
+      _unmap_all();
+      return;
+    }
+
+    columns.push_back(static_cast<const uint8_t*>(addr));
+    map_sizes.push_back(info.st_size);
+    types.push_back(defs[i].type);
+
+    if (memcmp(addr, &header, sizeof(header)) != 0) {
+      _unmap_all();
+      return;
+    }
+
+    // Queries scan columns front to back
+    madvise(addr, info.st_size, MADV_SEQUENTIAL);
+
+    int64_t rows = (info.st_size - sizeof(header)) / header.width;
+    if (i == 0 || rows < num_rows) num_rows = rows;
+  }
+#endif
+}
+
+ResultsArchiveReader::~ResultsArchiveReader()
+{
+  _unmap_all();
+}
+
+void ResultsArchiveReader::_unmap_all()
+{
+#ifndef _WIN32
+  for (size_t i = 0; i < columns.size(); i++) {
+    munmap(const_cast<uint8_t*>(columns[i]), map_sizes[i]);
+  }
+#endif
+  columns.clear();
+  map_sizes.clear();
+  types.clear();
+  num_rows = 0;
+}
+
+bool ResultsArchiveReader::is_open()
+{
+  return !columns.empty();
+}
+
+int64_t ResultsArchiveReader::get_num_rows()
+{
+  return num_rows;
+}
+
+int ResultsArchiveReader::find_column(const std::string& name)
+{
+  const std::vector<ResultsColumn_t>& defs = results_archive_columns();
+  for (size_t i = 0; i < defs.size(); i++) {
+    if (defs[i].name == name) return i;
+  }
+  return -1;
+}
+
+bool parse_results_filter(ResultsArchiveReader& reader, const std::string& expr, ResultsFilter_t& out)
+{
+  // Two-character operators are tried first
+  const char* ops[]         = {"==", "!=", "<=", ">=", "<", ">"};
+  const FilterOp_e op_ids[] = {FILTER_EQ, FILTER_NE, FILTER_LE, FILTER_GE, FILTER_LT, FILTER_GT};
+  for (int i = 0; i < MAX_FILTER_OPS; i++)
+  {
+    size_t pos = expr.find(ops[i]);
+    if (pos == std::string::npos) continue;
+
+    out.column = reader.find_column(expr.substr(0, pos));
+    out.op     = op_ids[i];
+    out.value  = atof(expr.substr(pos + strlen(ops[i])).c_str());
+    if (out.column < 0) return false;
+
+    // Compare at storage precision; a widened float never equals most decimals
+    if (results_archive_columns()[out.column].type == COL_FLOAT) out.value = (float)out.value;
+    return true;
+  }
+  return false;
+}
+
+bool results_filter_matches(ResultsArchiveReader& reader, const ResultsFilter_t& filter, int64_t row)
+{
+  double lhs = reader.get_value(filter.column, row);
+  switch (filter.op) {
+    case FILTER_EQ: return lhs == filter.value;
+    case FILTER_NE: return lhs != filter.value;
+    case FILTER_LT: return lhs < filter.value;
+    case FILTER_LE: return lhs <= filter.value;
+    case FILTER_GT: return lhs > filter.value;
+    default:        return lhs >= filter.value;
+  }
+}
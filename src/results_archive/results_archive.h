@@ -0,0 +1,248 @@
+/**
+ * @brief Columnar results archive
+ *
+ * An archive is a directory holding one file per column. Each file is a
+ * small header followed by fixed-width values, one per run, so appending a
+ * run is one buffered write per column, and readers memory-map only the
+ * columns a query touches, paging them in as they scan. The archive's row
+ * count is that of its shortest column: a run interrupted mid-append is
+ * never visible, and is trimmed the next time the archive is opened for
+ * appending.
+ *
+ * NOTE: not supported on Windows; writers and readers simply stay closed there.
+ */
+
+#ifndef _RESULTS_ARCHIVE_H_
+#define _RESULTS_ARCHIVE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <types.h>
+
+// Column file identification, checked on open
+#define RESULTS_ARCHIVE_MAGIC   (0x45565241) // "EVRA"
+#define RESULTS_ARCHIVE_VERSION (1)
+
+// Column file name suffix
+#define RESULTS_COLUMN_EXT ".col"
+
+// Value types a column can hold
+typedef enum _Column_Type {
+  COL_INT32,
+  COL_INT64,
+  COL_FLOAT,
+  MAX_COL_TYPES
+} ColumnType_e;
+
+// Filter comparison operators
+typedef enum _Filter_Op {
+  FILTER_EQ,
+  FILTER_NE,
+  FILTER_LT,
+  FILTER_LE,
+  FILTER_GT,
+  FILTER_GE,
+  MAX_FILTER_OPS
+} FilterOp_e;
+
+// Header at the start of every column file
+typedef struct ColumnHeader_t {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t type;   // ColumnType_e
+  uint32_t width;  // Bytes per value
+} ColumnHeader_t;
+
+// Configuration and results of one run, i.e. one archive row
+typedef struct RunRecord_t {
+  int32_t num_vtols;                            // Fleet size (mix is in company_stats)
+  int32_t num_chargers;                         // Number of chargers
+  float tick_rate;                              // Hours passed per tick
+  float sim_time_hr;                            // Simulated duration
+  int64_t seed;                                 // Base fault seed (-1 if unseeded)
+  CompanyStats_t company_stats[MAX_COMPANIES];  // Per-company metrics
+} RunRecord_t;
+
+// Column definition: name, value type and location within a RunRecord_t
+typedef struct ResultsColumn_t {
+  std::string name;
+  ColumnType_e type;
+  size_t offset;
+} ResultsColumn_t;
+
+// Row filter: column <op> value
+typedef struct ResultsFilter_t {
+  int column;
+  FilterOp_e op;
+  double value;     // Rounded to the column's storage precision
+} ResultsFilter_t;
+
+/**
+ * @brief Get the archive's column definitions, in file order
+ *
+ * Configuration columns come first (num_vtols, num_chargers, tick_rate,
+ * sim_time_hr, seed), then per company, prefixed with its lowercase name:
+ * <company>_vtols, _flight_time_hr, _flight_distance_mi, _charging_time_hr,
+ * _waiting_time_hr, _faults and _passenger_miles
+ *
+ * @return const std::vector<ResultsColumn_t>& - Column definitions
+ */
+const std::vector<ResultsColumn_t>& results_archive_columns();
+
+class ResultsArchiveWriter {
+  private:
+    std::vector<FILE*> files;  // One per column, empty if not open
+    int64_t num_rows;          // Complete rows in the archive
+
+    /**
+     * @brief Close all column files, leaving the writer closed
+     */
+    void _close_all();
+
+  public:
+    /**
+     * @brief Open an archive for appending, creating it if needed
+     *
+     * Columns left longer than the rest by an interrupted append are trimmed
+     *
+     * @param dir - Archive directory
+     */
+    ResultsArchiveWriter(const char* dir);
+
+    /**
+     * @brief Flush and close all column files
+     */
+    ~ResultsArchiveWriter();
+
+    /**
+     * @brief Check if the archive was opened successfully
+     *
+     * @return true - If appends are possible
+     * @return false - If the directory or a column file couldn't be opened,
+     * or a column file doesn't match the expected layout
+     */
+    bool is_open();
+
+    /**
+     * @brief Append one run to every column
+     *
+     * Writes are buffered; they are flushed by flush() or on destruction
+     *
+     * @param record - Run configuration and results
+     * @return true - If every column was written
+     * @return false - If the archive is not open or a write failed
+     */
+    bool append(const RunRecord_t& record);
+
+    /**
+     * @brief Flush buffered rows to the column files
+     *
+     * @return true - If all columns were flushed
+     */
+    bool flush();
+
+    /**
+     * @brief Get the number of rows in the archive, including appended ones
+     *
+     * @return int64_t - Number of runs
+     */
+    int64_t get_num_rows();
+};
+
+class ResultsArchiveReader {
+  private:
+    std::vector<const uint8_t*> columns;  // Mapped column files, empty if not open
+    std::vector<size_t> map_sizes;        // Mapped length of each column file
+    std::vector<ColumnType_e> types;      // Value type of each column
+    int64_t num_rows;                     // Complete rows in the archive
+
+    /**
+     * @brief Unmap all column files, leaving the reader closed
+     */
+    void _unmap_all();
+
+  public:
+    /**
+     * @brief Map every column of an archive read-only
+     *
+     * Mapping is lazy, so only the pages of columns actually read are loaded
+     *
+     * @param dir - Archive directory
+     */
+    ResultsArchiveReader(const char* dir);
+
+    /**
+     * @brief Unmap all column files
+     */
+    ~ResultsArchiveReader();
+
+    /**
+     * @brief Check if the archive was mapped and has a matching layout
+     *
+     * @return true - If reads are possible
+     * @return false - If the archive doesn't exist or is incompatible
+     */
+    bool is_open();
+
+    /**
+     * @brief Get the number of complete rows
+     *
+     * @return int64_t - Number of runs
+     */
+    int64_t get_num_rows();
+
+    /**
+     * @brief Look up a column index by name
+     *
+     * @param name - Column name, as per results_archive_columns
+     * @return int - Column index, or -1 if there is no such column
+     */
+    int find_column(const std::string& name);
+
+    /**
+     * @brief Read one value, converted to double
+     *
+     * @param column - Column index
+     * @param row - Row index (must be below get_num_rows)
+     * @return double - Value
+     */
+    double get_value(int column, int64_t row) {
+      const uint8_t* values = columns[column] + sizeof(ColumnHeader_t);
+      switch (types[column]) {
+        case COL_INT32: return reinterpret_cast<const int32_t*>(values)[row];
+        case COL_INT64: return reinterpret_cast<const int64_t*>(values)[row];
+        default:        return reinterpret_cast<const float*>(values)[row];
+      }
+    }
+};
+
+/**
+ * @brief Parse a "<col><op><value>" filter expression
+ *
+ * The value is rounded to the column's type, so that e.g. tick_rate==0.05
+ * compares against the float actually stored rather than the double 0.05.
+ * Every operator compares against that rounded value, so a stored 0.05f
+ * also passes tick_rate<=0.05 and fails tick_rate<0.05, even though 0.05f
+ * is slightly above the decimal 0.05
+ *
+ * @param reader - Archive the filter applies to
+ * @param expr - Filter expression (op: == != < <= > >=)
+ * @param out - Parsed filter
+ * @return true - If the expression names an existing column
+ * @return false - If it is malformed or the column doesn't exist
+ */
+bool parse_results_filter(ResultsArchiveReader& reader, const std::string& expr, ResultsFilter_t& out);
+
+/**
+ * @brief Check if a row passes a filter
+ *
+ * @param reader - Archive to read from
+ * @param filter - Filter, as per parse_results_filter
+ * @param row - Row index (must be below get_num_rows)
+ * @return true - If the row's value satisfies the filter
+ */
+bool results_filter_matches(ResultsArchiveReader& reader, const ResultsFilter_t& filter, int64_t row);
+
+#endif // _RESULTS_ARCHIVE_H_
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <types.h>
+#include <dual.h>
+#include <evtol_sim.h>
+#include <global_clk.h>
+#include <charger.h>
+#include <company_stats.h>
+#include <fleet_core.h>
+#include "sensitivity_sim.h"
+
+using namespace std;
+
+// Column headers for parameter derivatives, in VTOL_Param_e order
+static const char* PARAM_NAMES[MAX_PARAMS] = {
+  "d/cruise_mph", "d/battery_kwh", "d/chg_time_hr", "d/kwh_per_mi", "d/fault_prob"
+};
+
+// Faults are discrete draws, so no statistic carries a derivative w.r.t. the
+// fault probability; that column is left out rather than shown as zeros
+static bool is_displayed_param(int param)
+{
+  return param != FAULT_PROB;
+}
+
+SensitivitySim::SensitivitySim(int num_vtols, int num_chargers, float tick_rate, VTOL_Comp_e comp)
+  : FleetCore_T<Dual>(num_chargers, tick_rate, COMP_MAP)
+{
+  verbose = true;
+  _add_vtols(num_vtols, comp);
+}
+
+SensitivitySim::SensitivitySim(const vector<VTOL_Comp_e>& companies, int num_chargers, float tick_rate,
+                               const map<VTOL_Comp_e, VTOLParams_t>& comp_params)
+  : FleetCore_T<Dual>(num_chargers, tick_rate, comp_params)
+{
+  verbose = true;
+  for (VTOL_Comp_e company : companies) {
+    _add_vtol(company);
+  }
+}
+
+VTOLParams_T<Dual> SensitivitySim::_vtol_params(VTOL_Comp_e company)
+{
+  // Seed one derivative direction per company parameter
+  const VTOLParams_t& base = comp_params.at(company);
+  VTOLParams_T<Dual> params = {
+    Dual(base.cruise_speed_mph,      DUAL_DIR(company, CRUISE_SPEED)),
+    Dual(base.battery_capacity_kwh,  DUAL_DIR(company, BATTERY_CAPACITY)),
+    Dual(base.chg_time_hr,           DUAL_DIR(company, CHG_TIME)),
+    Dual(base.energy_use_kwh_per_mi, DUAL_DIR(company, ENERGY_USE)),
+    Dual(base.fault_prob_per_hr,     DUAL_DIR(company, FAULT_PROB))
+  };
+  return params;
+}
+
+void SensitivitySim::sim_flight(float sim_time_hr)
+{
+  if (verbose) cout << "Beginning Sensitivity Sim, simulated duration: " << sim_time_hr << " hours" << endl;
+  float start_timestamp = scalar_value(global_clk->get_timestamp());
+  end_timestamp = start_timestamp + sim_time_hr;
+
+  // Same ticks and completion check as FlightSim, so the value part
+  // matches a float run
+  int pct_complete = 0;
+  while (pct_complete < 100)
+  {
+    _sim_tick();
+    pct_complete = calc_pct_complete(scalar_value(global_clk->get_timestamp()) - start_timestamp, sim_time_hr);
+  }
+
+  if (verbose) cout << "\nCompleted " << sim_time_hr << " hour sensitivity simulation!" << endl;
+}
+
+CompanyStats_T<Dual> SensitivitySim::get_company_stats(VTOL_Comp_e company)
+{
+  return compute_company_stats<Dual>(company, evtol_companies[company]);
+}
+
+// Print one metric row: value, then derivatives w.r.t. the company's own parameters
+static void print_sens_row(const char* label, const Dual& metric, VTOL_Comp_e company)
+{
+  cout << "\t" << left << setw(23) << label << right << setw(12) << metric.val;
+  for (int param = 0; param < MAX_PARAMS; param++) {
+    if (is_displayed_param(param)) cout << setw(15) << metric.der[DUAL_DIR(company, param)];
+  }
+  cout << endl;
+}
+
+void SensitivitySim::set_verbose(bool verbose)
+{
+  this->verbose = verbose;
+}
+
+void SensitivitySim::display_sensitivities()
+{
+  cout << "Company Sensitivities:" << endl;
+  cout << "(no " << PARAM_NAMES[FAULT_PROB] << " column: faults are discrete random draws and carry no derivative)\n" << endl;
+  for (int company = 0; company < MAX_COMPANIES; company++)
+  {
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(company);
+    if (evtol_companies[company].empty())
+    {
+      cout << "No eVTOLs instantiated for " << COMP_NAMES.at(comp_enum) << " company.\n" << endl;
+      continue;
+    }
+
+    CompanyStats_T<Dual> comp_stats = get_company_stats(comp_enum);
+
+    cout << COMP_NAMES.at(comp_enum) << " Sensitivities:" << endl;
+    cout << "\t" << left << setw(23) << "" << right << setw(12) << "Value";
+    for (int param = 0; param < MAX_PARAMS; param++) {
+      if (is_displayed_param(param)) cout << setw(15) << PARAM_NAMES[param];
+    }
+    cout << endl;
+    print_sens_row("Avg. Flight Time:",      comp_stats.avg_flight_time_hr,     comp_enum);
+    print_sens_row("Avg. Flight Distance:",  comp_stats.avg_flight_distance_mi, comp_enum);
+    print_sens_row("Avg. Charging Time:",    comp_stats.avg_charging_time_hr,   comp_enum);
+    print_sens_row("Total Passenger Miles:", comp_stats.total_passenger_miles,  comp_enum);
+    print_sens_row("Avg. Waiting Time:",     comp_stats.avg_waiting_time_hr,    comp_enum);
+    cout << endl; // Extra line break between company stats blocks
+  }
+}
@@ -0,0 +1,97 @@
+/**
+ * Forward-mode sensitivity simulator
+ * 
+ * Runs the same fleet simulation as FlightSim (sharing its FleetCore_T
+ * instantiation and tick processing), but over dual numbers. Every company parameter is seeded as its
+ * own derivative direction, so one run yields the per-company statistics
+ * and their derivatives with respect to all company parameters.
+ */
+
+#ifndef _SENSITIVITY_SIM_
+#define _SENSITIVITY_SIM_
+
+#include <memory>
+#include <vector>
+#include <types.h>
+#include <dual.h>
+#include <evtol_sim.h>
+#include <global_clk.h>
+#include <charger.h>
+#include <fleet_core.h>
+
+using namespace std;
+
+class SensitivitySim : public FleetCore_T<Dual> {
+
+  private:
+    float end_timestamp;
+    bool verbose; // Print progress messages from sim_flight
+
+    /**
+     * @brief Get company parameters, each seeded as its own derivative direction
+     * 
+     * @param company - Company designation
+     * @return VTOLParams_T<Dual> - Vehicle parameters
+     */
+    VTOLParams_T<Dual> _vtol_params(VTOL_Comp_e company) override;
+
+  public:
+    /**
+     * @brief Construct a new Sensitivity Sim object
+     * 
+     * @param num_vtols - Number of eVTOLs to simulate
+     * @param num_chargers - Number of chargers to simulate
+     * @param tick_rate - Hours passed per tick
+     * @param comp - Company designation (default random)
+     */
+    SensitivitySim(int num_vtols, int num_chargers, float tick_rate, VTOL_Comp_e comp = MAX_COMPANIES);
+
+    /**
+     * @brief Construct a new Sensitivity Sim object with an explicit fleet mix
+     * 
+     * @param companies - Company designation of each eVTOL, in order
+     * @param num_chargers - Number of chargers to simulate
+     * @param tick_rate - Hours passed per tick
+     * @param comp_params - Parameters per company, derivatives are taken around
+     */
+    SensitivitySim(const vector<VTOL_Comp_e>& companies, int num_chargers, float tick_rate,
+                   const map<VTOL_Comp_e, VTOLParams_t>& comp_params = COMP_MAP);
+
+    /**
+     * @brief Simulate flight for all VTOLs for the given amount of time
+     * 
+     * @param sim_time_hr - Simulation time in hours
+     */
+    void sim_flight(float sim_time_hr);
+
+    /**
+     * @brief Get aggregated statistics and derivatives for one company
+     * 
+     * Derivative of a metric w.r.t. parameter p of company c is at index
+     * DUAL_DIR(c, p), allowing cross-company effects (e.g. via charger
+     * contention) to be read out as well.
+     * 
+     * NOTE: fault counts are integers drawn at random and carry no derivative
+     * 
+     * @param company - Company designation
+     * @return CompanyStats_T<Dual> - Averages and totals with derivatives
+     */
+    CompanyStats_T<Dual> get_company_stats(VTOL_Comp_e company);
+
+    /**
+     * @brief Enable/disable progress messages printed by sim_flight
+     * 
+     * @param verbose - True to print (default)
+     */
+    void set_verbose(bool verbose);
+
+    /**
+     * @brief Print per-company statistics and their derivatives w.r.t. that
+     * company's own parameters
+     * 
+     * The fault probability is left out, as fault draws carry no derivative
+     */
+    void display_sensitivities();
+};
+
+#endif // _SENSITIVITY_SIM_
@@ -0,0 +1,210 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <types.h>
+#include "stats_reduce.h"
+
+#define EXACT_SUM_LIMB_MASK ((1LL << EXACT_SUM_LIMB_BITS) - 1)
+
+// Bits in a double's mantissa, including the implicit leading bit
+#define DOUBLE_MANTISSA_BITS (53)
+
+ExactSum::ExactSum()
+{
+  for (int i = 0; i < EXACT_SUM_NUM_LIMBS; i++) limbs[i] = 0;
+  pending     = 0;
+  special     = 0;
+  has_special = false;
+}
+
+void ExactSum::add(double value)
+{
+  if (!std::isfinite(value)) {
+    special    += value;
+    has_special = true;
+    return;
+  }
+  if (value == 0) return;
+
+  // value = mantissa * 2^(exp - 53), with an integer mantissa below 2^53
+  int exp;
+  double frac      = frexp(value, &exp);
+  int64_t mantissa = (int64_t)ldexp(frac, DOUBLE_MANTISSA_BITS);
+  int64_t sign     = (mantissa < 0) ? -1 : 1;
+  uint64_t mag     = (uint64_t)(sign * mantissa);
+
+  int pos   = exp - DOUBLE_MANTISSA_BITS + EXACT_SUM_BIAS;
+  int limb  = pos / EXACT_SUM_LIMB_BITS;
+  int shift = pos % EXACT_SUM_LIMB_BITS;
+
+  // mag << shift is up to 85 bits; split it across three limbs
+  uint64_t lo = (mag & EXACT_SUM_LIMB_MASK) << shift;
+  uint64_t hi = (mag >> EXACT_SUM_LIMB_BITS) << shift;
+  limbs[limb]     += sign * (int64_t)(lo & EXACT_SUM_LIMB_MASK);
+  limbs[limb + 1] += sign * (int64_t)((lo >> EXACT_SUM_LIMB_BITS) + (hi & EXACT_SUM_LIMB_MASK));
+  limbs[limb + 2] += sign * (int64_t)(hi >> EXACT_SUM_LIMB_BITS);
+
+  if (++pending >= EXACT_SUM_MAX_PENDING) _normalize();
+}
+
+void ExactSum::merge(const ExactSum& other)
+{
+  ExactSum normalized = other;
+  normalized._normalize();
+  _normalize();
+
+  // Both sides are below 2^32 per limb, so this can't overflow
+  for (int i = 0; i < EXACT_SUM_NUM_LIMBS; i++) limbs[i] += normalized.limbs[i];
+  _normalize();
+
+  if (other.has_special) {
+    special    += other.special;
+    has_special = true;
+  }
+}
+
+void ExactSum::_normalize()
+{
+  for (int i = 0; i < EXACT_SUM_NUM_LIMBS - 1; i++)
+  {
+    // Floor division by 2^32, so the remainder is non-negative
+    int64_t carry = limbs[i] >> EXACT_SUM_LIMB_BITS;
+    limbs[i]     -= carry * (1LL << EXACT_SUM_LIMB_BITS);
+    limbs[i + 1] += carry;
+  }
+  pending = 0;
+}
+
+double ExactSum::value()
+{
+  if (has_special) return special;
+  _normalize();
+
+  // Round the magnitude, so every limb is non-negative
+  bool negative = limbs[EXACT_SUM_NUM_LIMBS - 1] < 0;
+  int64_t mag[EXACT_SUM_NUM_LIMBS];
+  int64_t borrow = 0;
+  for (int i = 0; i < EXACT_SUM_NUM_LIMBS; i++)
+  {
+    if (!negative) {
+      mag[i] = limbs[i];
+      continue;
+    }
+    // Two's complement style negation of the canonical form
+    int64_t limb = -limbs[i] - borrow;
+    borrow = (limb < 0 && i < EXACT_SUM_NUM_LIMBS - 1) ? 1 : 0;
+    mag[i] = limb + borrow * (1LL << EXACT_SUM_LIMB_BITS);
+  }
+
+  int top_limb = EXACT_SUM_NUM_LIMBS - 1;
+  while (top_limb >= 0 && mag[top_limb] == 0) top_limb--;
+  if (top_limb < 0) return 0;
+
+  // Take the 64 bits below the leading one, and OR every bit under them
+  // into the lowest (sticky) bit. That is 11 bits past a double's mantissa,
+  // so the integer-to-double conversion rounds exactly as rounding the
+  // exact total would
+  int top_bit = EXACT_SUM_LIMB_BITS - 1;
+  while (((uint64_t)mag[top_limb] >> top_bit) == 0) top_bit--;
+  int low_bit = top_limb * EXACT_SUM_LIMB_BITS + top_bit - 63;
+
+  uint64_t window = 0;
+  bool sticky     = false;
+  for (int i = top_limb; i >= 0; i--)
+  {
+    uint64_t limb = mag[i];
+    int shift     = i * EXACT_SUM_LIMB_BITS - low_bit;
+    if (shift >= 0) {
+      window |= limb << shift;
+    } else if (shift > -EXACT_SUM_LIMB_BITS) {
+      window |= limb >> -shift;
+      sticky |= (limb & ((1ULL << -shift) - 1)) != 0;
+    } else {
+      sticky |= limb != 0;
+    }
+  }
+  if (sticky) window |= 1;
+
+  // Scaling is exact: a total in the denormal range is a multiple of the
+  // smallest denormal with at most 52 bits, so the conversion didn't round
+  double total = ldexp((double)window, low_bit - EXACT_SUM_BIAS);
+  return negative ? -total : total;
+}
+
+// Exact per-company totals over a range of eVTOLs
+typedef struct StatsPartial_t {
+  ExactSum fly_time_hr;
+  ExactSum fly_distance_mi;
+  ExactSum charge_time_hr;
+  ExactSum wait_time_hr;
+  ExactSum weighted_faults;
+  int64_t num_faults;
+} StatsPartial_t;
+
+// Accumulate vtols[begin, end) into a partial
+static void reduce_range(const std::vector<std::shared_ptr<eVTOL_Sim>>& vtols, size_t begin, size_t end, StatsPartial_t* out)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    VTOLStats_t* stats_p = vtols[i]->get_stats_ptr();
+    out->fly_time_hr.add(stats_p->vehicle_fly_time_hr);
+    out->fly_distance_mi.add(stats_p->vehicle_fly_distance_mi);
+    out->charge_time_hr.add(stats_p->total_charge_time_hr);
+    out->wait_time_hr.add(stats_p->charge_wait_time_hr);
+    out->weighted_faults.add(stats_p->num_faults * exp(stats_p->fault_log_weight));
+    out->num_faults += stats_p->num_faults;
+  }
+}
+
+CompanyStats_t reduce_company_stats(VTOL_Comp_e company, const std::vector<std::shared_ptr<eVTOL_Sim>>& vtols, int num_threads)
+{
+  CompanyStats_t out = CompanyStats_t();
+  out.num_vtols = vtols.size();
+  if (vtols.empty()) return out;
+
+  if (num_threads > (int)vtols.size()) num_threads = vtols.size();
+  if (num_threads < 1) num_threads = 1;
+
+  // Any split gives the same exact totals; contiguous chunks keep each
+  // thread on its own part of the array
+  std::vector<StatsPartial_t> partials(num_threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < num_threads; t++)
+  {
+    partials[t].num_faults = 0;
+    size_t begin = vtols.size() * t / num_threads;
+    size_t end   = vtols.size() * (t + 1) / num_threads;
+    if (t == num_threads - 1) {
+      // Calling thread takes the last chunk
+      reduce_range(vtols, begin, end, &partials[t]);
+    } else {
+      workers.push_back(std::thread(reduce_range, std::cref(vtols), begin, end, &partials[t]));
+    }
+  }
+  for (std::thread& worker : workers) worker.join();
+
+  StatsPartial_t& total = partials[0];
+  for (int t = 1; t < num_threads; t++)
+  {
+    total.fly_time_hr.merge(partials[t].fly_time_hr);
+    total.fly_distance_mi.merge(partials[t].fly_distance_mi);
+    total.charge_time_hr.merge(partials[t].charge_time_hr);
+    total.wait_time_hr.merge(partials[t].wait_time_hr);
+    total.weighted_faults.merge(partials[t].weighted_faults);
+    total.num_faults += partials[t].num_faults;
+  }
+
+  double num_vtols   = vtols.size();
+  double distance_mi = total.fly_distance_mi.value();
+  out.avg_flight_time_hr     = total.fly_time_hr.value() / num_vtols;
+  out.avg_flight_distance_mi = distance_mi / num_vtols;
+  out.avg_charging_time_hr   = total.charge_time_hr.value() / num_vtols;
+  out.avg_waiting_time_hr    = total.wait_time_hr.value() / num_vtols;
+  out.total_faults           = total.num_faults;
+  out.weighted_faults        = total.weighted_faults.value();
+  out.total_passenger_miles  = distance_mi * VTOL_PASSENGERS.at(company);
+  return out;
+}
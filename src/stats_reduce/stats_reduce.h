@@ -0,0 +1,95 @@
+/**
+ * @brief Reproducible parallel reduction of fleet statistics
+ *
+ * Float sums depend on the order they're added in, so a parallel (or
+ * sharded) version of compute_company_stats would give different answers
+ * for different thread counts. Here every sum is accumulated exactly in a
+ * superaccumulator: a wide fixed-point integer covering the whole double
+ * range, to which each value adds without rounding. Partial sums from any
+ * number of threads then merge into the same exact total, which is rounded
+ * once at the end, so results are bit-identical for 1 or 128 threads.
+ */
+
+#ifndef _STATS_REDUCE_H_
+#define _STATS_REDUCE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <types.h>
+#include <evtol_sim.h>
+
+// Accumulator layout: 32 value bits per limb. Bit 0 is 2^-EXACT_SUM_BIAS,
+// low enough for the smallest denormal's mantissa, and the limbs reach past
+// the largest double with room for carries
+#define EXACT_SUM_LIMB_BITS (32)
+#define EXACT_SUM_BIAS      (1126)
+#define EXACT_SUM_NUM_LIMBS (72)
+
+// Adds between carry propagations; each add moves a limb by < 2^33, so
+// this keeps every limb well inside int64
+#define EXACT_SUM_MAX_PENDING (1 << 28)
+
+class ExactSum {
+  private:
+    int64_t limbs[EXACT_SUM_NUM_LIMBS]; // Little-endian, signed limbs
+    int64_t pending;                    // Adds since the last carry propagation
+    double special;                     // Sum of infinities/NaNs (order-independent)
+    bool has_special;
+
+    /**
+     * @brief Propagate carries, leaving every limb but the top in [0, 2^32)
+     *
+     * The representation is then unique for a given total
+     */
+    void _normalize();
+
+  public:
+    /**
+     * @brief Construct a zero sum
+     */
+    ExactSum();
+
+    /**
+     * @brief Add a value, exactly
+     *
+     * @param value - Value to add
+     */
+    void add(double value);
+
+    /**
+     * @brief Add another partial sum, exactly
+     *
+     * @param other - Partial sum
+     */
+    void merge(const ExactSum& other);
+
+    /**
+     * @brief Round the exact total to the nearest double (ties to even)
+     *
+     * @return double - Total (infinity/NaN if any were added)
+     */
+    double value();
+};
+
+/**
+ * @brief Aggregate statistics over all eVTOLs of one company, in parallel
+ *
+ * Same outputs as compute_company_stats, but every total is summed exactly
+ * and averages are taken from the rounded totals, so the result doesn't
+ * depend on num_threads. It can differ from compute_company_stats (which
+ * rounds after every add) in the last bits.
+ *
+ * Each call starts num_threads - 1 std::threads and joins them before
+ * returning; there is no pool. At tens of microseconds per thread that only
+ * pays off for companies of many thousands of eVTOLs, and FlightSim calls
+ * this once per company per stats query, not per tick.
+ *
+ * @param company - Company designation
+ * @param vtols - All eVTOL instances of that company
+ * @param num_threads - Worker threads (clamped to [1, number of eVTOLs])
+ * @return CompanyStats_t - Averages and totals for the company
+ */
+CompanyStats_t reduce_company_stats(VTOL_Comp_e company, const std::vector<std::shared_ptr<eVTOL_Sim>>& vtols, int num_threads);
+
+#endif // _STATS_REDUCE_H_
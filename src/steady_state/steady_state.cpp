@@ -0,0 +1,146 @@
+#include <cmath>
+#include <vector>
+#include "steady_state.h"
+
+SteadyStateDetector::SteadyStateDetector(int num_series)
+{
+  this->num_series = num_series;
+  mser_batches.resize(num_series);
+  partial_sums.assign(num_series, 0);
+  partial_count = 0;
+
+  truncation_batches = 0;
+  window_batches     = 0;
+  means.assign(num_series, 0);
+  half_widths.assign(num_series, 0);
+}
+
+void SteadyStateDetector::add_observation(const float* obs)
+{
+  for (int i = 0; i < num_series; i++) partial_sums[i] += obs[i];
+
+  // Only keep MSER batch means, to avoid storing every tick
+  if (++partial_count < MSER_BATCH_SIZE) return;
+
+  for (int i = 0; i < num_series; i++) {
+    mser_batches[i].push_back(partial_sums[i] / MSER_BATCH_SIZE);
+    partial_sums[i] = 0;
+  }
+  partial_count = 0;
+}
+
+int SteadyStateDetector::_mser_truncation(int series)
+{
+  const std::vector<float>& z = mser_batches[series];
+  int n = z.size();
+
+  // Walk backwards accumulating suffix sums, so that each candidate
+  // truncation point d is evaluated in O(1)
+  // MSER(d) = sum_{j>=d} (z_j - mean_d)^2 / (n - d)^2
+  double sum = 0, sum_sq = 0;
+  double best_stat = INFINITY;
+  int best_d = 0;
+  for (int d = n - 1; d >= 0; d--) {
+    sum    += z[d];
+    sum_sq += (double)z[d] * z[d];
+
+    // Only consider truncating up to half the data, as per MSER convention
+    if (d > n / 2) continue;
+
+    double count = n - d;
+    double ssd   = sum_sq - (sum * sum) / count;
+    double stat  = ssd / (count * count);
+    if (stat <= best_stat) {
+      best_stat = stat;
+      best_d    = d;
+    }
+  }
+
+  return best_d;
+}
+
+bool SteadyStateDetector::evaluate(float rel_precision, float abs_precision)
+{
+  int n = get_num_obs() / MSER_BATCH_SIZE;
+
+  // Need at least two MSER batches per CI batch after truncating half
+  if (n < 4 * NUM_CI_BATCHES) return false;
+
+  truncation_batches = 0;
+  for (int i = 0; i < num_series; i++) {
+    int d = _mser_truncation(i);
+    if (d > truncation_batches) truncation_batches = d;
+  }
+
+  // Split remaining data into equal batches, dropping any remainder from
+  // the start of the window (closest to the warm-up period)
+  int batch_len = (n - truncation_batches) / NUM_CI_BATCHES;
+  int start     = n - batch_len * NUM_CI_BATCHES;
+
+  bool converged = true;
+  for (int i = 0; i < num_series; i++) {
+    const std::vector<float>& z = mser_batches[i];
+    double batch_means[NUM_CI_BATCHES];
+    double grand_mean = 0;
+    for (int b = 0; b < NUM_CI_BATCHES; b++) {
+      double batch_sum = 0;
+      for (int j = 0; j < batch_len; j++) batch_sum += z[start + b * batch_len + j];
+      batch_means[b] = batch_sum / batch_len;
+      grand_mean += batch_means[b] / NUM_CI_BATCHES;
+    }
+
+    double var = 0;
+    for (int b = 0; b < NUM_CI_BATCHES; b++) {
+      var += (batch_means[b] - grand_mean) * (batch_means[b] - grand_mean);
+    }
+    var /= (NUM_CI_BATCHES - 1);
+
+    means[i]       = grand_mean;
+    half_widths[i] = CI_T_QUANTILE * sqrt(var / NUM_CI_BATCHES);
+
+    // A series at (or near) zero, e.g. no waiting at all, can't meet a
+    // relative target, so the absolute floor settles it
+    if (half_widths[i] > fmax(rel_precision * fabs(means[i]), abs_precision)) converged = false;
+  }
+
+  // Report the truncation point as the start of the batch-means window
+  truncation_batches = start;
+  window_batches     = n - start;
+
+  return converged;
+}
+
+int SteadyStateDetector::get_truncated_obs()
+{
+  return truncation_batches * MSER_BATCH_SIZE;
+}
+
+int SteadyStateDetector::get_num_obs()
+{
+  return mser_batches.empty() ? 0 : mser_batches[0].size() * MSER_BATCH_SIZE;
+}
+
+int SteadyStateDetector::get_num_batches()
+{
+  return mser_batches.empty() ? 0 : mser_batches[0].size();
+}
+
+int SteadyStateDetector::get_truncated_batches()
+{
+  return truncation_batches;
+}
+
+int SteadyStateDetector::get_window_batches()
+{
+  return window_batches;
+}
+
+float SteadyStateDetector::get_mean(int series)
+{
+  return means[series];
+}
+
+float SteadyStateDetector::get_half_width(int series)
+{
+  return half_widths[series];
+}
@@ -0,0 +1,138 @@
+/**
+ * @brief Steady-state detector for per-tick simulation output
+ *
+ * Collects one observation per tick for a fixed number of output series,
+ * truncates the warm-up transient using MSER-5 and estimates confidence
+ * intervals on the remaining data using non-overlapping batch means.
+ *
+ */
+
+#ifndef _STEADY_STATE_H_
+#define _STEADY_STATE_H_
+
+#include <vector>
+
+// MSER batch size (observations averaged per MSER batch)
+#define MSER_BATCH_SIZE (5)
+
+// Number of batches used for batch-means confidence intervals
+#define NUM_CI_BATCHES  (20)
+
+// Student-t quantile for 95% two-sided interval with NUM_CI_BATCHES - 1 DOF
+#define CI_T_QUANTILE   (2.093)
+
+// Default absolute CI half-width floor, so series settled at (or near) zero
+// converge. Series are fractions in [0, 1], so this is 0.1 percentage points
+#define DEFAULT_ABS_PRECISION (1e-3)
+
+class SteadyStateDetector {
+  private:
+    int num_series; // Number of output series tracked
+
+    // MSER-5 batch means, one vector per series
+    std::vector<std::vector<float>> mser_batches;
+
+    // Partial sums for the MSER batch currently being filled
+    std::vector<double> partial_sums;
+    int partial_count;
+
+    // Results of the most recent evaluation
+    int truncation_batches;         // Number of MSER batches dropped as warm-up
+    int window_batches;             // Number of MSER batches in the CI window
+    std::vector<float> means;       // Truncated mean per series
+    std::vector<float> half_widths; // CI half-width per series
+
+    /**
+     * @brief Compute the MSER-5 truncation point for one series
+     *
+     * @param series - Series index
+     * @return int - Number of MSER batches to drop as warm-up
+     */
+    int _mser_truncation(int series);
+
+  public:
+    /**
+     * @brief Construct a new Steady State Detector object
+     *
+     * @param num_series - Number of series in each observation
+     */
+    SteadyStateDetector(int num_series);
+
+    /**
+     * @brief Add one observation (one value per series)
+     *
+     * @param obs - Array of num_series values
+     */
+    void add_observation(const float* obs);
+
+    /**
+     * @brief Truncate warm-up and compute batch-means confidence intervals
+     *
+     * The truncation point is the largest MSER-5 point over all series, so
+     * that every series is evaluated over the same steady-state window. A
+     * series meets the target once its CI half-width is within
+     * max(rel_precision * |mean|, abs_precision).
+     *
+     * @param rel_precision - Target CI half-width relative to the mean
+     * @param abs_precision - Absolute half-width that always meets the target
+     * @return true - If there is enough data and every series meets the target
+     * @return false - Otherwise
+     */
+    bool evaluate(float rel_precision, float abs_precision = DEFAULT_ABS_PRECISION);
+
+    /**
+     * @brief Get the number of observations dropped as warm-up
+     *
+     * @return int - Observations truncated at the last evaluation
+     */
+    int get_truncated_obs();
+
+    /**
+     * @brief Get the number of complete observations collected
+     *
+     * @return int - Observations collected (in full MSER batches)
+     */
+    int get_num_obs();
+
+    /**
+     * @brief Get the number of complete MSER batches collected
+     *
+     * @return int - MSER batches (observations / MSER_BATCH_SIZE)
+     */
+    int get_num_batches();
+
+    /**
+     * @brief Get the number of MSER batches dropped as warm-up
+     *
+     * @return int - Batches before the steady-state window, as of the last evaluation
+     */
+    int get_truncated_batches();
+
+    /**
+     * @brief Get the number of MSER batches in the steady-state window
+     *
+     * The window ends at get_truncated_batches() + this, which may be short
+     * of get_num_batches() if data arrived since the last evaluation
+     *
+     * @return int - Batches used for the CIs at the last evaluation
+     */
+    int get_window_batches();
+
+    /**
+     * @brief Get the steady-state mean of a series
+     *
+     * @param series - Series index
+     * @return float - Mean after truncation, as of the last evaluation
+     */
+    float get_mean(int series);
+
+    /**
+     * @brief Get the confidence interval half-width of a series
+     *
+     * @param series - Series index
+     * @return float - 95% CI half-width, as of the last evaluation
+     */
+    float get_half_width(int series);
+};
+
+#endif // _STEADY_STATE_H_
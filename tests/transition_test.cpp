@@ -12,13 +12,24 @@
  * 
  */
 
+#include <algorithm>
 #include <iostream>
+#include <cmath>
+#include <cstring>
 #include <deque>
 #include <types.h>
 #include <evtol_sim.h>
 #include <global_clk.h>
 #include <charger.h>
 #include <flight_sim.h>
+#include <sensitivity_sim.h>
+#include <fault_tail.h>
+#include <batch_sim.h>
+#include <results_archive.h>
+#include <aggregate_sim.h>
+#include <stats_reduce.h>
+#include <live_metrics.h>
+#include <thread>
 
 FlightSim* sim_inst;
 #define HR_PER_TICK (0.05)
@@ -78,11 +89,712 @@ void test_five_vehicles()
 
 }
 
+void test_steady_state()
+{
+  cout << "Testing run to steady state" << endl;
+
+  std::vector<VTOL_Comp_e> mix;
+  for (int i = 0; i < 20; i++) mix.push_back(static_cast<VTOL_Comp_e>(i % MAX_COMPANIES));
+  float rel_precision = 0.05;
+
+  FlightSim sim(mix, NUM_CHARGERS, HR_PER_TICK);
+  sim.display_company_makeup();
+  bool converged = sim.sim_until_converged(500.0, rel_precision);
+  sim.display_steady_state_stats();
+
+  // Long reference run, to a tighter precision
+  FlightSim ref(mix, NUM_CHARGERS, HR_PER_TICK);
+  ref.set_verbose(false);
+  ref.sim_until_converged(5000.0, rel_precision / 5, 1.0, DEFAULT_ABS_PRECISION / 5);
+
+  // All vehicles start in flight, so there is a warm-up to drop
+  shared_ptr<SteadyStateDetector> det     = sim.get_steady_state_detector();
+  shared_ptr<SteadyStateDetector> ref_det = ref.get_steady_state_detector();
+  int mismatches = (converged && det->get_truncated_obs() > 0) ? 0 : 1;
+  for (int series = 0; series < SS_NUM_SERIES; series++)
+  {
+    // Each interval meets the requested precision
+    float mean = det->get_mean(series), half_width = det->get_half_width(series);
+    if (half_width > fmax(rel_precision * fabs(mean), DEFAULT_ABS_PRECISION)) ++mismatches;
+
+    // The truncated mean agrees with the reference, within both intervals
+    if (fabs(mean - ref_det->get_mean(series)) > half_width + ref_det->get_half_width(series)) ++mismatches;
+  }
+
+  // Window statistics match the state fractions the detector watched: hours
+  // flying or waiting per vehicle-hour of the window
+  float window_hr = sim.get_steady_state_window_hr();
+  for (int comp = 0; comp < MAX_COMPANIES; comp++)
+  {
+    CompanyStats_t window_stats = sim.get_steady_state_company_stats(static_cast<VTOL_Comp_e>(comp));
+    if (fabs(window_stats.avg_flight_time_hr / window_hr - det->get_mean(SS_FLIGHT_SERIES(comp))) > 0.01) ++mismatches;
+    if (fabs(window_stats.avg_waiting_time_hr / window_hr - det->get_mean(SS_WAIT_SERIES(comp))) > 0.01) ++mismatches;
+  }
+
+  // With 8 chargers some waiting fractions settle near zero, which only the
+  // absolute floor lets converge
+  FlightSim light(mix, 8, HR_PER_TICK);
+  light.set_verbose(false);
+  if (!light.sim_until_converged(2000.0, rel_precision)) ++mismatches;
+
+  cout << (mismatches == 0 ? "PASSED" : "FAILED") << endl;
+}
+
+// Check an estimate is within a relative tolerance of a reference (exact if the reference is 0)
+bool within_rel(double actual, double expected, double rel_tol)
+{
+  return fabs(actual - expected) <= rel_tol * fabs(expected);
+}
+
+void test_sensitivities()
+{
+  cout << "Testing parameter sensitivities" << endl;
+
+  std::vector<VTOL_Comp_e> mix;
+  for (int i = 0; i < 20; i++) mix.push_back(static_cast<VTOL_Comp_e>(i % MAX_COMPANIES));
+  SensitivitySim sens_inst(mix, NUM_CHARGERS, HR_PER_TICK);
+
+  sens_inst.sim_flight(3.0);
+
+  sens_inst.display_sensitivities();
+
+  // The value part is the float run, bit for bit, so the two take the same
+  // branches at every tick
+  int mismatches = 0;
+  FlightSim float_sim(mix, NUM_CHARGERS, HR_PER_TICK);
+  float_sim.set_verbose(false);
+  float_sim.sim_flight(3.0);
+  for (int comp = 0; comp < MAX_COMPANIES; comp++)
+  {
+    CompanyStats_t expected    = float_sim.get_company_stats(static_cast<VTOL_Comp_e>(comp));
+    CompanyStats_T<Dual> sens  = sens_inst.get_company_stats(static_cast<VTOL_Comp_e>(comp));
+    float expected_vals[] = {expected.avg_flight_time_hr, expected.avg_flight_distance_mi, expected.avg_charging_time_hr,
+                             expected.avg_waiting_time_hr, expected.total_passenger_miles};
+    float sens_vals[]     = {sens.avg_flight_time_hr.val, sens.avg_flight_distance_mi.val, sens.avg_charging_time_hr.val,
+                             sens.avg_waiting_time_hr.val, sens.total_passenger_miles.val};
+    if (memcmp(expected_vals, sens_vals, sizeof(expected_vals)) != 0) ++mismatches;
+  }
+
+  // d(avg flight time)/d(battery_kwh) against a central difference of two
+  // float runs at +-h. No event sits on a tick boundary in this run, so the
+  // stats are smooth in each battery capacity around the default
+  for (int comp = 0; comp < MAX_COMPANIES; comp++)
+  {
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(comp);
+    float h = 1e-3 * COMP_MAP.at(comp_enum).battery_capacity_kwh;
+    std::map<VTOL_Comp_e, VTOLParams_t> params_up = COMP_MAP, params_down = COMP_MAP;
+    params_up[comp_enum].battery_capacity_kwh   += h;
+    params_down[comp_enum].battery_capacity_kwh -= h;
+
+    FlightSim sim_up(mix, NUM_CHARGERS, HR_PER_TICK, params_up);
+    FlightSim sim_down(mix, NUM_CHARGERS, HR_PER_TICK, params_down);
+    sim_up.set_verbose(false);
+    sim_down.set_verbose(false);
+    sim_up.sim_flight(3.0);
+    sim_down.sim_flight(3.0);
+
+    double finite_diff = (sim_up.get_company_stats(comp_enum).avg_flight_time_hr -
+                          sim_down.get_company_stats(comp_enum).avg_flight_time_hr) / (2 * h);
+    double derivative  = sens_inst.get_company_stats(comp_enum).avg_flight_time_hr.der[DUAL_DIR(comp_enum, BATTERY_CAPACITY)];
+    if (!within_rel(finite_diff, derivative, 1e-3)) ++mismatches;
+  }
+
+  cout << (mismatches == 0 ? "PASSED" : "FAILED") << endl;
+}
+
+void test_fault_tail()
+{
+  cout << "Testing fault tail estimation (crude vs. importance sampling)" << endl;
+
+  // 2+ faults in a shift is uncommon, 3+ is rare (a handful of crude hits)
+  int thresholds[]      = {2, 3};
+  float tilted_rates[]  = {1.6, 2.4};
+  int mismatches = 0;
+  for (int t = 0; t < 2; t++)
+  {
+    // Crude Monte Carlo reference
+    FaultTailEstimator crude(20, NUM_CHARGERS, HR_PER_TICK, 3.0, CHARLIE);
+    crude.run(20000, thresholds[t], 0);
+    crude.display_estimates();
+
+    // Importance sampling, 10x fewer runs
+    FaultTailEstimator tilted(20, NUM_CHARGERS, HR_PER_TICK, 3.0, CHARLIE);
+    tilted.run(2000, thresholds[t], tilted_rates[t]);
+    tilted.display_estimates();
+
+    // Both are unbiased, so should agree within 3 combined standard errors
+    FaultTailEstimate_t crude_est[] = {crude.get_fleet_estimate(), crude.get_vehicle_estimate(CHARLIE)};
+    FaultTailEstimate_t is_est[]    = {tilted.get_fleet_estimate(), tilted.get_vehicle_estimate(CHARLIE)};
+    for (int e = 0; e < 2; e++) {
+      double std_err = sqrt(crude_est[e].std_err * crude_est[e].std_err + is_est[e].std_err * is_est[e].std_err);
+      if (fabs(is_est[e].prob - crude_est[e].prob) > 3 * std_err) ++mismatches;
+    }
+
+    // At the rare threshold, importance sampling is more precise despite
+    // running 10x fewer replications (no crude hits counts as infinite error)
+    if (thresholds[t] == 3) {
+      for (int e = 0; e < 2; e++) {
+        double crude_rel = (crude_est[e].prob > 0) ? crude_est[e].std_err / crude_est[e].prob : INFINITY;
+        if (!(is_est[e].prob > 0 && is_est[e].std_err / is_est[e].prob < crude_rel)) ++mismatches;
+      }
+    }
+  }
+
+  cout << (mismatches == 0 ? "PASSED" : "FAILED") << endl;
+}
+
+
+void test_batch_sim()
+{
+  cout << "Testing batched scenarios against FlightSim" << endl;
+
+  // One fleet mix and charger count per lane
+  std::vector<BatchScenario_t> scenarios;
+  std::vector<std::vector<VTOL_Comp_e>> mixes;
+  for (int lane = 0; lane < BATCH_LANES; lane++) {
+    std::vector<VTOL_Comp_e> mix;
+    for (int i = 0; i < 20; i++) mix.push_back(static_cast<VTOL_Comp_e>((i * (lane + 1)) % MAX_COMPANIES));
+    mixes.push_back(mix);
+    scenarios.push_back(make_batch_scenario(mix, 1 + lane % NUM_CHARGERS, HR_PER_TICK, lane));
+  }
+
+  BatchFlightSim batch_inst(scenarios);
+  batch_inst.sim_flight(3.0);
+
+  // Non-fault statistics should be identical lane by lane
+  int mismatches = 0;
+  for (int lane = 0; lane < BATCH_LANES; lane++) {
+    FlightSim ref(mixes[lane], 1 + lane % NUM_CHARGERS, HR_PER_TICK);
+    ref.set_verbose(false);
+    ref.sim_flight(3.0);
+
+    for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+      CompanyStats_t expected = ref.get_company_stats(static_cast<VTOL_Comp_e>(comp));
+      CompanyStats_t actual   = batch_inst.get_company_stats(lane, static_cast<VTOL_Comp_e>(comp));
+      if (expected.avg_flight_time_hr     != actual.avg_flight_time_hr     ||
+          expected.avg_flight_distance_mi != actual.avg_flight_distance_mi ||
+          expected.avg_charging_time_hr   != actual.avg_charging_time_hr   ||
+          expected.avg_waiting_time_hr    != actual.avg_waiting_time_hr) {
+        cout << "Mismatch in lane " << lane << ", company " << COMP_NAMES.at(static_cast<VTOL_Comp_e>(comp)) << endl;
+        ++mismatches;
+      }
+    }
+  }
+
+  cout << (mismatches ? "FAILED" : "PASSED") << endl;
+}
+
+void test_fast_forward()
+{
+  cout << "Testing fast-forward against detailed ticks" << endl;
+
+  // Long horizon, lightly loaded (12 chargers) and contended (6 chargers)
+  std::vector<VTOL_Comp_e> mix;
+  for (int i = 0; i < 20; i++) mix.push_back(static_cast<VTOL_Comp_e>(i % MAX_COMPANIES));
+
+  int mismatches = 0;
+  int charger_counts[] = {12, 6};
+  for (int num_chargers : charger_counts)
+  {
+    FlightSim detailed(mix, num_chargers, HR_PER_TICK);
+    detailed.set_verbose(false);
+    detailed.sim_flight(500.0);
+
+    FlightSim fast(mix, num_chargers, HR_PER_TICK);
+    fast.set_verbose(false);
+    fast.enable_fast_forward();
+    fast.sim_flight(500.0);
+
+    // Same transitions on the same ticks; only per-tick vs. per-phase
+    // accumulation of the totals differs, by float rounding
+    for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+      CompanyStats_t expected = detailed.get_company_stats(static_cast<VTOL_Comp_e>(comp));
+      CompanyStats_t actual   = fast.get_company_stats(static_cast<VTOL_Comp_e>(comp));
+      if (!within_rel(actual.avg_flight_time_hr,     expected.avg_flight_time_hr,     1e-4) ||
+          !within_rel(actual.avg_flight_distance_mi, expected.avg_flight_distance_mi, 1e-4) ||
+          !within_rel(actual.avg_charging_time_hr,   expected.avg_charging_time_hr,   1e-4) ||
+          !within_rel(actual.avg_waiting_time_hr,    expected.avg_waiting_time_hr,    1e-4)) {
+        cout << "Mismatch for company " << COMP_NAMES.at(static_cast<VTOL_Comp_e>(comp))
+             << " with " << num_chargers << " chargers" << endl;
+        ++mismatches;
+      }
+    }
+  }
+
+  cout << (mismatches ? "FAILED" : "PASSED") << endl;
+}
+
+void test_results_archive()
+{
+  cout << "Testing results archive round trip" << endl;
+
+  int num_vtols = 20;
+  test_setup(num_vtols);
+  sim_inst->set_verbose(false);
+  sim_inst->seed_faults(42);
+  sim_inst->sim_flight(3.0);
+  RunRecord_t record = sim_inst->get_run_record();
+
+  // Append to a scratch archive, then read the row back through the mapping
+  const char* dir = "build/test_archive";
+  int64_t row;
+  {
+    ResultsArchiveWriter writer(dir);
+    row = writer.get_num_rows();
+    writer.append(record);
+  }
+
+  ResultsArchiveReader reader(dir);
+  bool ok = reader.is_open() && reader.get_num_rows() == row + 1 &&
+            reader.get_value(reader.find_column("seed"), row) == 42 &&
+            reader.get_value(reader.find_column("num_vtols"), row) == num_vtols &&
+            reader.get_value(reader.find_column("alpha_flight_time_hr"), row) == record.company_stats[ALPHA].avg_flight_time_hr;
+
+  // Filters on float columns compare at storage precision, as typed on the command line
+  // with the same rounded value for every operator
+  const char* exprs[]   = {"tick_rate==0.05", "sim_time_hr==3", "tick_rate!=0.05", "tick_rate>=0.05", "tick_rate<0.05",
+                           "tick_rate<=0.05", "tick_rate>0.05", "tick_rate>0.049", "seed<43"};
+  const bool expected[] = {true,              true,             false,             true,              false,
+                           true,              false,            true,              true};
+  for (int i = 0; i < 9; i++)
+  {
+    ResultsFilter_t filter;
+    bool parsed = parse_results_filter(reader, exprs[i], filter);
+    bool match  = parsed && results_filter_matches(reader, filter, row);
+    if (match != expected[i]) {
+      cout << "Filter " << exprs[i] << (match ? " matched" : " did not match") << endl;
+      ok = false;
+    }
+  }
+
+  cout << (ok ? "PASSED" : "FAILED") << endl;
+}
+
+// Charging session for brute-force power checks
+typedef struct TestSession_t {
+  double start;
+  double end;
+  double power_kw;
+} TestSession_t;
+
+// Energy a session list draws over [start, end)
+double brute_energy_kwh(const std::vector<TestSession_t>& sessions, double start, double end)
+{
+  double energy = 0;
+  for (const TestSession_t& session : sessions) {
+    double overlap = std::min(session.end, end) - std::max(session.start, start);
+    if (overlap > 0) energy += session.power_kw * overlap;
+  }
+  return energy;
+}
+
+// Peak draw of a session list over [start, end); the level only changes
+// where a session starts or ends, so those are the only instants to check
+double brute_peak_kw(const std::vector<TestSession_t>& sessions, double start, double end)
+{
+  std::vector<double> instants(1, start);
+  for (const TestSession_t& session : sessions) {
+    if (session.start > start && session.start < end) instants.push_back(session.start);
+    if (session.end > start && session.end < end) instants.push_back(session.end);
+  }
+
+  double peak = 0;
+  for (double instant : instants) {
+    double level = 0;
+    for (const TestSession_t& session : sessions) {
+      if (session.start <= instant && instant < session.end) level += session.power_kw;
+    }
+    peak = std::max(peak, level);
+  }
+  return peak;
+}
+
+void test_power_timeline()
+{
+  cout << "Testing charger power-draw timeline" << endl;
+  int mismatches = 0;
+
+  // Hand-built sessions with known overlap: 100 kW alone, then 150, 180,
+  // 150, 50, idle and 80 kW
+  std::vector<TestSession_t> sessions = {
+    {0.0, 1.0, 100}, {0.5, 1.5, 50}, {0.6, 0.8, 30}, {2.0, 2.3, 80}
+  };
+  PowerTimeline timeline;
+  timeline.add_session(sessions[1].start, sessions[1].end, sessions[1].power_kw);
+  timeline.add_session(sessions[0].start, sessions[0].end, sessions[0].power_kw);
+  timeline.commit(0.55); // Later sessions start after each commit, as in the sim
+  timeline.add_session(sessions[2].start, sessions[2].end, sessions[2].power_kw);
+  timeline.commit(1.9);
+  timeline.add_session(sessions[3].start, sessions[3].end, sessions[3].power_kw);
+  timeline.commit(3.0);
+
+  // Ranges that split sessions, end exactly where one starts, or are idle
+  double ranges[][2] = {{0, 3.0}, {0.7, 1.2}, {0.25, 0.5}, {0.9, 2.1}, {1.5, 2.0}, {2.25, 2.5}};
+  for (auto& range : ranges)
+  {
+    double energy = brute_energy_kwh(sessions, range[0], range[1]);
+    if (fabs(timeline.get_peak_kw(range[0], range[1]) - brute_peak_kw(sessions, range[0], range[1])) > 1e-9) ++mismatches;
+    if (fabs(timeline.get_energy_kwh(range[0], range[1]) - energy) > 1e-9) ++mismatches;
+    if (fabs(timeline.get_avg_kw(range[0], range[1]) - energy / (range[1] - range[0])) > 1e-9) ++mismatches;
+  }
+
+  // 15-min windows from t=0; the 0.75 boundary splits three sessions and
+  // 2.25 splits the last one
+  double window_hr = 0.25;
+  double peak_demand = 0;
+  for (int i = 0; i * window_hr < 3.0; i++) {
+    peak_demand = std::max(peak_demand, brute_energy_kwh(sessions, i * window_hr, (i + 1) * window_hr) / window_hr);
+  }
+  if (fabs(timeline.get_peak_demand_kw(0, 3.0, window_hr) - peak_demand) > 1e-9) ++mismatches;
+
+  // And the values worked out by hand: 180 kW peak, (0.1 * 150 + 0.15 * 180) / 0.25
+  // over [0.5, 0.75)
+  if (fabs(timeline.get_peak_kw(0, 3.0) - 180) > 1e-9) ++mismatches;
+  if (fabs(peak_demand - 168) > 1e-9) ++mismatches;
+
+  // In the sim, energy drawn matches the charging time each eVTOL reports
+  int num_vtols = 20;
+  test_setup(num_vtols);
+  sim_inst->set_verbose(false);
+  sim_inst->enable_power_timeline();
+  sim_inst->sim_flight(24.0);
+  sim_inst->display_power_stats();
+
+  shared_ptr<PowerTimeline> sim_timeline = sim_inst->get_power_timeline();
+  double expected_energy = 0, max_power = 0;
+  for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+    VTOL_Comp_e comp_enum = static_cast<VTOL_Comp_e>(comp);
+    CompanyStats_t stats  = sim_inst->get_company_stats(comp_enum);
+    double power_kw = COMP_MAP.at(comp_enum).battery_capacity_kwh / COMP_MAP.at(comp_enum).chg_time_hr;
+    expected_energy += stats.avg_charging_time_hr * stats.num_vtols * power_kw;
+    max_power        = std::max(max_power, power_kw);
+  }
+  double end = sim_timeline->get_committed_timestamp();
+  if (!within_rel(sim_timeline->get_energy_kwh(0, end), expected_energy, 1e-4)) ++mismatches;
+  if (sim_timeline->get_peak_kw(0, end) > NUM_CHARGERS * max_power + 1e-9) ++mismatches;
+
+  cout << (mismatches == 0 ? "PASSED" : "FAILED") << endl;
+}
+
+void test_aggregate_sim()
+{
+  cout << "Testing aggregate sim against the agent model" << endl;
+
+  // Several charge cycles, at two fleet sizes with their chargers in use
+  int fleet_sizes[]  = {20, 100};
+  int charger_counts[] = {3, 15};
+  int mismatches = 0;
+  for (int run = 0; run < 2; run++)
+  {
+    std::vector<VTOL_Comp_e> mix;
+    for (int i = 0; i < fleet_sizes[run]; i++) mix.push_back(static_cast<VTOL_Comp_e>(i % MAX_COMPANIES));
+    FlightSim agent(mix, charger_counts[run], HR_PER_TICK);
+    agent.set_verbose(false);
+    agent.sim_flight(100.0);
+
+    // Same company mix, run for as long as the agent model actually ran
+    std::vector<int64_t> counts;
+    for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+      counts.push_back(agent.get_company_stats(static_cast<VTOL_Comp_e>(comp)).num_vtols);
+    }
+    AggregateSim agg_inst(counts, charger_counts[run], HR_PER_TICK);
+    agg_inst.sim_flight(agent.get_timestamp());
+    if (run == 0) agg_inst.display_error(agent);
+
+    // Which company gets a contended charger is down to vehicle order, so
+    // fleet-wide hours are held to 1%, and each company's averages to 2%
+    // (measured up to 1.3%). Faults are random draws and aren't compared
+    double expected_hr[3] = {}, actual_hr[3] = {};
+    for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+      CompanyStats_t expected = agent.get_company_stats(static_cast<VTOL_Comp_e>(comp));
+      CompanyStats_t actual   = agg_inst.get_company_stats(static_cast<VTOL_Comp_e>(comp));
+      if (actual.num_vtols != expected.num_vtols ||
+          !within_rel(actual.avg_flight_time_hr, expected.avg_flight_time_hr, 0.02) ||
+          !within_rel(actual.avg_flight_distance_mi, expected.avg_flight_distance_mi, 0.02) ||
+          !within_rel(actual.avg_charging_time_hr, expected.avg_charging_time_hr, 0.02) ||
+          !within_rel(actual.avg_waiting_time_hr, expected.avg_waiting_time_hr, 0.02)) {
+        cout << "Run " << run << ": " << COMP_NAMES.at(static_cast<VTOL_Comp_e>(comp)) << " off by more than 2%" << endl;
+        ++mismatches;
+      }
+      expected_hr[0] += expected.avg_flight_time_hr * expected.num_vtols;
+      actual_hr[0]   += actual.avg_flight_time_hr * actual.num_vtols;
+      expected_hr[1] += expected.avg_charging_time_hr * expected.num_vtols;
+      actual_hr[1]   += actual.avg_charging_time_hr * actual.num_vtols;
+      expected_hr[2] += expected.avg_waiting_time_hr * expected.num_vtols;
+      actual_hr[2]   += actual.avg_waiting_time_hr * actual.num_vtols;
+    }
+    for (int i = 0; i < 3; i++) {
+      if (!within_rel(actual_hr[i], expected_hr[i], 0.01)) ++mismatches;
+    }
+  }
+
+  cout << (mismatches == 0 ? "PASSED" : "FAILED") << endl;
+}
+
+void test_maintenance()
+{
+  cout << "Testing maintenance bay groundings" << endl;
+
+  int num_vtols = 20;
+  int num_bays  = 1;
+  test_setup(num_vtols);
+  sim_inst->set_verbose(false);
+  shared_ptr<MaintenanceBay> bay = sim_inst->enable_maintenance(num_bays);
+
+  // Check bay capacity every hour, then that every eVTOL's time adds up
+  bool passed = true;
+  for (int hour = 0; hour < 24; hour++) {
+    sim_inst->sim_flight(1.0);
+    int in_maintenance = 0;
+    for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+      for (shared_ptr<eVTOL_Sim> vtol : sim_inst->get_company_vtols(static_cast<VTOL_Comp_e>(comp))) {
+        if (vtol->get_state() == IN_MAINTENANCE) ++in_maintenance;
+      }
+    }
+    passed = passed && in_maintenance == bay->get_bays_in_use() && in_maintenance <= num_bays;
+  }
+
+  float elapsed_hr = 0;
+  for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+    for (shared_ptr<eVTOL_Sim> vtol : sim_inst->get_company_vtols(static_cast<VTOL_Comp_e>(comp))) {
+      VTOLStats_t* stats_p = vtol->get_stats_ptr();
+      float total_hr = stats_p->vehicle_fly_time_hr + stats_p->total_charge_time_hr + stats_p->charge_wait_time_hr +
+                       stats_p->maintenance_wait_time_hr + stats_p->maintenance_time_hr;
+      if (elapsed_hr == 0) elapsed_hr = total_hr;
+      passed = passed && fabs(total_hr - elapsed_hr) <= 1e-2;
+
+      // Only a faulty flight can ground an eVTOL
+      passed = passed && stats_p->num_groundings <= stats_p->num_faults;
+    }
+  }
+  sim_inst->display_maintenance_stats();
+
+  // Bays go out in landing order: one bay, fixed 1 hour service, requests
+  // made out of landing order
+  shared_ptr<GlobalClk> clk   = make_shared<GlobalClk>(0, HR_PER_TICK);
+  shared_ptr<Charger> charger = make_shared<Charger>(NUM_CHARGERS);
+  MaintenanceBay order_bay(1);
+  order_bay.set_service_time(ALPHA, 1.0, 0);
+  std::vector<shared_ptr<eVTOL_Sim>> grounded;
+  float landings_hr[]  = {0.3, 0.1, 0.2};
+  int expected_order[] = {1, 2, 0};
+  for (float landing_hr : landings_hr) {
+    grounded.push_back(make_shared<eVTOL_Sim>(ALPHA, clk, charger));
+    order_bay.request_bay(grounded.back().get(), landing_hr);
+  }
+  for (int k = 0; k < 3; k++) {
+    // Half-way through the k-th service
+    order_bay.process(0.6 + k);
+    if (grounded[expected_order[k]]->get_state() != IN_MAINTENANCE || order_bay.get_bays_in_use() != 1) {
+      cout << "Bay " << k << " not granted in landing order" << endl;
+      passed = false;
+    }
+  }
+
+  // Service times follow set_service_time: with a bay each, every service
+  // starts at t=0, so its duration is the eVTOL's maintenance time
+  int num_services = 1000;
+  MaintenanceBay service_bay(num_services);
+  service_bay.set_service_time(BRAVO, 1.5, 0.5);
+  service_bay.seed(7);
+  std::vector<shared_ptr<eVTOL_Sim>> serviced;
+  for (int i = 0; i < num_services; i++) {
+    serviced.push_back(make_shared<eVTOL_Sim>(BRAVO, clk, charger));
+    service_bay.request_bay(serviced.back().get(), 0);
+  }
+  service_bay.process(0);
+  service_bay.process(100);
+  double service_hr = 0;
+  for (shared_ptr<eVTOL_Sim> vtol : serviced) service_hr += vtol->get_stats_ptr()->maintenance_time_hr;
+  double mean_service_hr = service_hr / num_services;
+  if (service_bay.get_num_serviced(BRAVO) != num_services || !within_rel(mean_service_hr, 1.5, 0.05)) {
+    cout << "Mean service time " << mean_service_hr << " h, expected 1.5 h" << endl;
+    passed = false;
+  }
+
+  // Fast-forwarding with a charger per eVTOL replays bay events exactly, but
+  // draws faults in a different order, so compare fleet availability
+  std::vector<VTOL_Comp_e> mix;
+  for (int i = 0; i < 1000; i++) mix.push_back(static_cast<VTOL_Comp_e>(i % MAX_COMPANIES));
+  float availability[2] = {};
+  for (int fast = 0; fast < 2; fast++)
+  {
+    FlightSim fleet(mix, mix.size(), HR_PER_TICK);
+    fleet.set_verbose(false);
+    fleet.seed_faults(11);
+    fleet.enable_fast_forward(fast == 1);
+    shared_ptr<MaintenanceBay> fleet_bay = fleet.enable_maintenance(50);
+    fleet.sim_flight(100.0);
+
+    int in_maintenance = 0;
+    for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+      availability[fast] += fleet.get_availability(static_cast<VTOL_Comp_e>(comp)) / MAX_COMPANIES;
+      for (shared_ptr<eVTOL_Sim> vtol : fleet.get_company_vtols(static_cast<VTOL_Comp_e>(comp))) {
+        if (vtol->get_state() == IN_MAINTENANCE) ++in_maintenance;
+      }
+    }
+    passed = passed && in_maintenance == fleet_bay->get_bays_in_use();
+  }
+  if (!within_rel(availability[1], availability[0], 0.03)) {
+    cout << "Availability " << availability[1] << " when fast-forwarded, " << availability[0] << " detailed" << endl;
+    passed = false;
+  }
+
+  cout << (passed ? "PASSED" : "FAILED") << endl;
+}
+
+// Field by field, comparing floats bitwise (a struct memcmp would also
+// compare padding)
+static bool same_company_stats(const CompanyStats_t& a, const CompanyStats_t& b)
+{
+  return a.num_vtols == b.num_vtols && a.total_faults == b.total_faults &&
+         memcmp(&a.avg_flight_time_hr, &b.avg_flight_time_hr, sizeof(float)) == 0 &&
+         memcmp(&a.avg_flight_distance_mi, &b.avg_flight_distance_mi, sizeof(float)) == 0 &&
+         memcmp(&a.avg_charging_time_hr, &b.avg_charging_time_hr, sizeof(float)) == 0 &&
+         memcmp(&a.avg_waiting_time_hr, &b.avg_waiting_time_hr, sizeof(float)) == 0 &&
+         memcmp(&a.total_passenger_miles, &b.total_passenger_miles, sizeof(float)) == 0 &&
+         memcmp(&a.weighted_faults, &b.weighted_faults, sizeof(double)) == 0;
+}
+
+void test_stats_reduce()
+{
+  cout << "Testing reproducible parallel stats reduction" << endl;
+
+  int num_vtols = 200;
+  test_setup(num_vtols);
+  sim_inst->set_verbose(false);
+  sim_inst->sim_flight(3.0);
+
+  // Cancellation that order-dependent float sums get wrong
+  ExactSum sum;
+  sum.add(1e16);
+  sum.add(1);
+  sum.add(-1e16);
+  bool passed = (sum.value() == 1);
+
+  // Rounded once from the exact total: 1 + 2^-53 + 2^-100 is just above the
+  // halfway point, so it rounds up, where summing from the top would tie to 1
+  ExactSum above_half;
+  above_half.add(1);
+  above_half.add(ldexp(1.0, -53));
+  above_half.add(ldexp(1.0, -100));
+  passed = passed && above_half.value() == 1 + ldexp(1.0, -52);
+  ExactSum tie;
+  tie.add(-1);
+  tie.add(-ldexp(1.0, -53));
+  passed = passed && tie.value() == -1;
+  ExactSum denormal;
+  denormal.add(ldexp(1.0, -1074));
+  denormal.add(ldexp(3.0, -1074));
+  passed = passed && denormal.value() == ldexp(1.0, -1072);
+
+  // Bit-identical for any thread count, and close to the serial float sums
+  CompanyStats_t expected[MAX_COMPANIES];
+  sim_inst->set_stats_threads(1);
+  for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+    expected[comp] = sim_inst->get_company_stats(static_cast<VTOL_Comp_e>(comp));
+  }
+  for (int num_threads : {2, 3, 8, 128}) {
+    sim_inst->set_stats_threads(num_threads);
+    for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+      CompanyStats_t actual = sim_inst->get_company_stats(static_cast<VTOL_Comp_e>(comp));
+      passed = passed && same_company_stats(actual, expected[comp]);
+    }
+  }
+  sim_inst->set_stats_threads(0);
+  for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+    CompanyStats_t serial = sim_inst->get_company_stats(static_cast<VTOL_Comp_e>(comp));
+    passed = passed && fabs(serial.avg_flight_time_hr - expected[comp].avg_flight_time_hr) <= 1e-4 &&
+             serial.total_faults == expected[comp].total_faults;
+  }
+
+  cout << (passed ? "PASSED" : "FAILED") << endl;
+}
+
+// Snapshot number k, with every field derived from k
+static LiveMetricsData_t live_metrics_snapshot(int32_t k)
+{
+  LiveMetricsData_t data = {};
+  data.sim_time_hr     = k * HR_PER_TICK;
+  data.end_time_hr     = 2 * k * HR_PER_TICK;
+  data.pct_complete    = 50;
+  data.ticks_per_sec   = k;
+  data.tick_count      = k;
+  for (int comp = 0; comp < MAX_COMPANIES; comp++) {
+    for (int state = 0; state < MAX_STATES; state++) data.state_counts[comp][state] = k + comp + state;
+  }
+  data.chargers_in_use = k;
+  data.num_chargers    = k;
+  data.wait_q_len      = k;
+  data.running         = 1;
+  return data;
+}
+
+void test_live_metrics()
+{
+  cout << "Testing live metrics publish/read under concurrent updates" << endl;
+
+  const char* name = "/evtol_sim_metrics_test";
+  const int num_reads = 2000000;
+  int mismatches = 0;
+  {
+    LiveMetricsPublisher publisher(name);
+    if (!publisher.is_open()) {
+      cout << "Could not create " << name << " (left over from an earlier run?)" << endl;
+      ++mismatches;
+    }
+
+    // An existing segment is never taken over
+    LiveMetricsPublisher second(name);
+    if (second.is_open()) ++mismatches;
+
+    // Nothing published yet, so the page must not be read as a finished run
+    LiveMetricsReader reader(name);
+    if (!reader.is_open() || reader.get_sequence() != 0) ++mismatches;
+
+    // The writer keeps publishing until the reader is done, so reads overlap
+    // writes (by preemption, even on one core)
+    std::atomic<bool> reads_done(false);
+    int32_t num_publishes = 0;
+    std::thread writer([&]() {
+      while (!reads_done.load()) publisher.publish(live_metrics_snapshot(++num_publishes));
+    });
+
+    // Every snapshot read must be one whole publish, and never go backwards
+    int64_t last_k = 0;
+    LiveMetricsData_t data;
+    for (int read = 0; read < num_reads && mismatches == 0; read++)
+    {
+      if (reader.get_sequence() == 0 || !reader.read(data)) continue;
+      LiveMetricsData_t expected = live_metrics_snapshot(data.tick_count);
+      if (memcmp(&data, &expected, sizeof(data)) != 0 || data.tick_count < last_k) ++mismatches;
+      last_k = data.tick_count;
+    }
+    reads_done = true;
+    writer.join();
+
+    if (reader.get_sequence() != 2 * (uint32_t)num_publishes) ++mismatches;
+    if (!reader.read(data) || data.tick_count != num_publishes) ++mismatches;
+  }
+
+  cout << (mismatches ? "FAILED" : "PASSED") << endl;
+}
 
 int main(int argc, char *argv[])
 {
   // test_single_vehicle();
   // test_two_vehicles();
   test_five_vehicles();
+  // test_steady_state();
+  // test_sensitivities();
+  // test_fault_tail();
+  // test_batch_sim();
+  // test_fast_forward();
+  // test_results_archive();
+  // test_power_timeline();
+  // test_aggregate_sim();
+  // test_maintenance();
+  // test_stats_reduce();
+  // test_live_metrics();
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * @file batch_bench.cpp
+ * @brief Throughput of BatchFlightSim against sequential FlightSim runs
+ *
+ * Usage: batch_bench [sim hours] [repetitions]
+ *
+ * Runs the same BATCH_LANES scenarios (15-22 vehicles, 1-3 chargers) once
+ * as a single batch and once as one FlightSim per scenario, and prints
+ * scenarios per second for each. Both paths are compiled into this binary
+ * with the same flags, so the ratio reflects the engines and not the build
+ * (see OPT in the Makefile).
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <batch_sim.h>
+#include <flight_sim.h>
+
+using namespace std;
+
+#define DEFAULT_BENCH_HOURS (300.0)
+#define DEFAULT_BENCH_REPS  (3)
+#define BENCH_TICK_RATE     (0.05)
+
+// Seconds elapsed since start
+static double elapsed_s(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+  float sim_hours = (argc > 1) ? atof(argv[1]) : DEFAULT_BENCH_HOURS;
+  int num_reps    = (argc > 2) ? atoi(argv[2]) : DEFAULT_BENCH_REPS;
+  if (sim_hours <= 0 || num_reps < 1) {
+    cerr << "Usage: " << argv[0] << " [sim hours] [repetitions]" << endl;
+    return 1;
+  }
+
+  vector<BatchScenario_t> scenarios;
+  vector<vector<VTOL_Comp_e>> mixes;
+  vector<int> num_chargers;
+  for (int lane = 0; lane < BATCH_LANES; lane++) {
+    vector<VTOL_Comp_e> mix;
+    for (int i = 0; i < 15 + lane; i++) mix.push_back(static_cast<VTOL_Comp_e>((i * (lane + 1)) % MAX_COMPANIES));
+    mixes.push_back(mix);
+    num_chargers.push_back(1 + lane % 3);
+    scenarios.push_back(make_batch_scenario(mix, num_chargers.back(), BENCH_TICK_RATE, lane));
+  }
+
+  // Best of num_reps for each, to keep scheduler noise out of the ratio
+  double batch_s = 0, sequential_s = 0;
+  for (int rep = 0; rep < num_reps; rep++)
+  {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    BatchFlightSim batch_inst(scenarios);
+    batch_inst.sim_flight(sim_hours);
+    double run_s = elapsed_s(start);
+    if (rep == 0 || run_s < batch_s) batch_s = run_s;
+
+    start = chrono::steady_clock::now();
+    for (int lane = 0; lane < BATCH_LANES; lane++) {
+      FlightSim ref(mixes[lane], num_chargers[lane], BENCH_TICK_RATE);
+      ref.set_verbose(false);
+      ref.sim_flight(sim_hours);
+    }
+    run_s = elapsed_s(start);
+    if (rep == 0 || run_s < sequential_s) sequential_s = run_s;
+  }
+
+  cout << BATCH_LANES << " scenarios, " << sim_hours << " h each, best of " << num_reps << endl;
+  cout << "  BatchFlightSim:       " << batch_s << " s (" << BATCH_LANES / batch_s << " scenarios/s)" << endl;
+  cout << "  Sequential FlightSim: " << sequential_s << " s (" << BATCH_LANES / sequential_s << " scenarios/s)" << endl;
+  cout << "  Speedup:              " << sequential_s / batch_s << "x" << endl;
+  return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file metrics_reader.cpp
+ * @brief Standalone monitor for the live metrics page published by FlightSim
+ * 
+ * Usage: metrics_reader [segment name] [poll interval ms]
+ * 
+ * Waits for the first publish (the page reads as not running until then),
+ * then polls the shared memory segment and prints a status line per poll
+ * until the run finishes.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <types.h>
+#include <live_metrics.h>
+
+using namespace std;
+
+#define DEFAULT_POLL_MS (500)
+
+int main(int argc, char *argv[])
+{
+  const char* name = (argc > 1) ? argv[1] : LIVE_METRICS_SHM_NAME;
+  int poll_ms      = (argc > 2) ? atoi(argv[2]) : DEFAULT_POLL_MS;
+
+  LiveMetricsReader reader(name);
+  if (!reader.is_open()) {
+    cerr << "No live metrics segment '" << name << "' found" << endl;
+    return 1;
+  }
+
+  // A segment is created before its run starts; don't mistake the empty
+  // page for a finished run
+  if (reader.get_sequence() == 0) cout << "Waiting for the first publish" << endl;
+  while (reader.get_sequence() == 0) this_thread::sleep_for(chrono::milliseconds(poll_ms));
+
+  LiveMetricsData_t data;
+  while (reader.read(data))
+  {
+    cout << data.pct_complete << "% @ " << data.sim_time_hr << "/" << data.end_time_hr << " hr"
+         << ", " << data.ticks_per_sec << " ticks/s"
+         << ", chargers " << data.chargers_in_use << "/" << data.num_chargers
+         << ", wait_q " << data.wait_q_len << endl;
+
+    for (int company = 0; company < MAX_COMPANIES; company++) {
+      cout << "\t" << COMP_NAMES.at(static_cast<VTOL_Comp_e>(company)) << ":\t"
+           << "flying " << data.state_counts[company][IN_FLIGHT]
+           << ", charging " << data.state_counts[company][CHARGING]
+           << ", waiting " << data.state_counts[company][WAITING_TO_CHARGE]
+           << ", grounded " << data.state_counts[company][WAITING_FOR_MAINTENANCE] + data.state_counts[company][IN_MAINTENANCE] << endl;
+    }
+
+    if (!data.running) break;
+    this_thread::sleep_for(chrono::milliseconds(poll_ms));
+  }
+
+  return 0;
+}
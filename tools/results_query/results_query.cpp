@@ -0,0 +1,181 @@
+/**
+ * @file results_query.cpp
+ * @brief Offline filter/group/aggregate queries over a results archive
+ *
+ * Usage: results_query <archive dir> [options]
+ *   --columns                  List columns and the row count
+ *   --where <col><op><value>   Keep rows matching (op: == != < <= > >=), repeatable
+ *   --group-by <col>           Group rows by a column's value
+ *   --agg <func>:<col>         Aggregate per group (count, sum, mean, min, max), repeatable
+ *
+ * Example: results_query runs --where num_chargers==3 --group-by seed --agg mean:alpha_waiting_time_hr
+ *
+ * The archive is memory-mapped and scanned row by row, touching only the
+ * columns named in the query, so it is never loaded fully into memory.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+#include <results_archive.h>
+
+using namespace std;
+
+// Aggregate: func(column)
+typedef struct QueryAgg_t {
+  string func;
+  int column;   // -1 for count
+  string label;
+} QueryAgg_t;
+
+// Running aggregates for one group
+typedef struct QueryAcc_t {
+  int64_t count;
+  vector<double> sum;
+  vector<double> min;
+  vector<double> max;
+} QueryAcc_t;
+
+static void print_usage()
+{
+  cerr << "Usage: results_query <archive dir> [--columns] [--where <col><op><value>]..."
+       << " [--group-by <col>] [--agg <count|sum|mean|min|max>:<col>]..." << endl;
+}
+
+// Split "<func>:<col>"; count needs no column
+static bool parse_agg(ResultsArchiveReader& reader, const string& expr, QueryAgg_t& out)
+{
+  size_t pos  = expr.find(':');
+  out.func    = expr.substr(0, pos);
+  out.label   = expr;
+  out.column  = -1;
+  if (out.func == "count") return true;
+  if (pos == string::npos) return false;
+  if (out.func != "sum" && out.func != "mean" && out.func != "min" && out.func != "max") return false;
+
+  out.column = reader.find_column(expr.substr(pos + 1));
+  return out.column >= 0;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2) {
+    print_usage();
+    return 1;
+  }
+
+  ResultsArchiveReader reader(argv[1]);
+  if (!reader.is_open()) {
+    cerr << "No results archive found at '" << argv[1] << "'" << endl;
+    return 1;
+  }
+
+  vector<ResultsFilter_t> filters;
+  vector<QueryAgg_t> aggs;
+  int group_column = -1;
+  for (int i = 2; i < argc; i++)
+  {
+    string arg = argv[i];
+    if (arg == "--columns") {
+      cout << reader.get_num_rows() << " rows" << endl;
+      for (const ResultsColumn_t& column : results_archive_columns()) cout << "\t" << column.name << endl;
+      return 0;
+    }
+
+    if (i + 1 >= argc) {
+      print_usage();
+      return 1;
+    }
+    string value = argv[++i];
+
+    bool ok = false;
+    if (arg == "--where") {
+      ResultsFilter_t filter;
+      ok = parse_results_filter(reader, value, filter);
+      filters.push_back(filter);
+    } else if (arg == "--group-by") {
+      group_column = reader.find_column(value);
+      ok = group_column >= 0;
+    } else if (arg == "--agg") {
+      QueryAgg_t agg;
+      ok = parse_agg(reader, value, agg);
+      aggs.push_back(agg);
+    }
+
+    if (!ok) {
+      cerr << "Invalid argument: " << arg << " " << value << endl;
+      print_usage();
+      return 1;
+    }
+  }
+  if (aggs.empty()) {
+    QueryAgg_t count;
+    parse_agg(reader, "count", count);
+    aggs.push_back(count);
+  }
+
+  // Single scan; groups are keyed (and printed) in order of value
+  map<double, QueryAcc_t> groups;
+  for (int64_t row = 0; row < reader.get_num_rows(); row++)
+  {
+    bool keep = true;
+    for (const ResultsFilter_t& filter : filters) {
+      if (!results_filter_matches(reader, filter, row)) {
+        keep = false;
+        break;
+      }
+    }
+    if (!keep) continue;
+
+    double key = (group_column >= 0) ? reader.get_value(group_column, row) : 0;
+    QueryAcc_t& acc = groups[key];
+    if (acc.count == 0) {
+      acc.sum.assign(aggs.size(), 0);
+      acc.min.assign(aggs.size(), 0);
+      acc.max.assign(aggs.size(), 0);
+    }
+
+    for (size_t a = 0; a < aggs.size(); a++)
+    {
+      if (aggs[a].column < 0) continue;
+      double value = reader.get_value(aggs[a].column, row);
+      acc.sum[a] += value;
+      if (acc.count == 0 || value < acc.min[a]) acc.min[a] = value;
+      if (acc.count == 0 || value > acc.max[a]) acc.max[a] = value;
+    }
+    ++acc.count;
+  }
+
+  // Without grouping there is always one line, even if no row matched
+  if (group_column < 0 && groups.empty()) {
+    QueryAcc_t& acc = groups[0];
+    acc.count = 0;
+    acc.sum.assign(aggs.size(), 0);
+    acc.min.assign(aggs.size(), NAN);
+    acc.max.assign(aggs.size(), NAN);
+  }
+
+  // Tab-separated, one line per group
+  if (group_column >= 0) cout << results_archive_columns()[group_column].name << "\t";
+  for (size_t a = 0; a < aggs.size(); a++) cout << aggs[a].label << (a + 1 < aggs.size() ? "\t" : "\n");
+
+  for (const pair<const double, QueryAcc_t>& group : groups)
+  {
+    const QueryAcc_t& acc = group.second;
+    if (group_column >= 0) cout << group.first << "\t";
+    for (size_t a = 0; a < aggs.size(); a++)
+    {
+      const string& func = aggs[a].func;
+      if (func == "count")     cout << acc.count;
+      else if (func == "sum")  cout << acc.sum[a];
+      else if (func == "mean") cout << (acc.count ? acc.sum[a] / acc.count : NAN);
+      else if (func == "min")  cout << acc.min[a];
+      else                     cout << acc.max[a];
+      cout << (a + 1 < aggs.size() ? "\t" : "\n");
+    }
+  }
+
+  return 0;
+}